@@ -0,0 +1,90 @@
+#ifndef MYC_CPU_DISPATCH_H
+#define MYC_CPU_DISPATCH_H
+
+/*
+ * Runtime selection of the compression functions.
+ *
+ * CPU features are detected once, on the first hash computed, and each
+ * compression/permutation function is bound to the best implementation
+ * the CPU supports. The choice can be capped with the
+ * MYC_HASHING_BACKEND environment variable ("scalar", "ssse3", "avx2",
+ * "avx512", "shani" or "auto") or with myc_dispatch_set_backend().
+ *
+ * Backends are ordered scalar < ssse3 < avx2 < avx512 < shani. Capping
+ * at a backend selects, for every algorithm, the best implementation
+ * not above it, so an algorithm without an implementation for the
+ * requested backend falls back to the next one down.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Feature bits returned by myc_cpu_features() */
+#define MYC_CPU_SSSE3     (1u << 0)
+#define MYC_CPU_SSE41     (1u << 1)
+#define MYC_CPU_AVX       (1u << 2)
+#define MYC_CPU_AVX2      (1u << 3)
+#define MYC_CPU_BMI1      (1u << 4)
+#define MYC_CPU_BMI2      (1u << 5)
+#define MYC_CPU_AVX512F   (1u << 6)
+#define MYC_CPU_AVX512VL  (1u << 7)
+#define MYC_CPU_AVX512BW  (1u << 8)
+#define MYC_CPU_SHA       (1u << 9)
+
+typedef enum {
+    MYC_BACKEND_AUTO = 0,
+    MYC_BACKEND_SCALAR,
+    MYC_BACKEND_SSSE3,
+    MYC_BACKEND_AVX2,
+    MYC_BACKEND_AVX512,
+    MYC_BACKEND_SHANI
+} myc_backend;
+
+typedef enum {
+    MYC_HASH_SHA256 = 0,    /* SHA-224/256 block transform */
+    MYC_HASH_SHA512,        /* SHA-384/512 block transform */
+    MYC_HASH_KECCAK,        /* Keccak-f[1600] permutation */
+    MYC_HASH_RIPEMD160,     /* RIPEMD-160 block transform */
+    MYC_HASH_COUNT,
+    MYC_HASH_ALL = MYC_HASH_COUNT
+} myc_hash_alg;
+
+/* CPU features usable by this process (OS support included) */
+unsigned int myc_cpu_features(void);
+
+/*
+ * Cap the backend used by one algorithm, or by all of them with
+ * MYC_HASH_ALL. MYC_BACKEND_AUTO removes the cap. Returns 0 on success
+ * and -1 on invalid arguments. Not safe to call while other threads
+ * are hashing.
+ */
+int myc_dispatch_set_backend(myc_hash_alg alg, myc_backend backend);
+
+/*
+ * Time the implementations of every algorithm the CPU supports, for
+ * one stream and for each batch size class, and bind the fastest ones.
+ * This takes a few milliseconds. When cache_path is given, the choices
+ * saved there by an earlier call on the same CPU are used instead,
+ * and new measurements are saved to it. Caps still apply: a tuned
+ * choice above the cap of its algorithm is ignored. Setting the
+ * MYC_HASHING_AUTOTUNE environment variable to a cache path (or to an
+ * empty string for no cache) does the same on the first hash.
+ *
+ * Returns 1 when the choices were read from the cache, 0 when they
+ * were measured and -1 when they were measured but could not be saved.
+ * Not safe to call while other threads are hashing.
+ */
+int myc_dispatch_autotune(const char *cache_path);
+
+/* Backend currently bound to an algorithm */
+myc_backend myc_dispatch_backend(myc_hash_alg alg);
+
+/* Name of a backend, as accepted by MYC_HASHING_BACKEND */
+const char *myc_dispatch_backend_name(myc_backend backend);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !MYC_CPU_DISPATCH_H */
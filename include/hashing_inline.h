@@ -0,0 +1,179 @@
+#ifndef MYC_HASHING_INLINE_H
+#define MYC_HASHING_INLINE_H
+
+/*
+ * Inline one-shot hashing.
+ *
+ * myc_sha256_inline(), myc_sha3_256_inline(), myc_keccak_256_inline()
+ * and myc_ripemd160_inline() give the same digests as myc_sha256(),
+ * myc_sha3_256(), myc_keccak_256() and myc_ripemd160(), but the state
+ * setup, the padding and the output are compiled into the caller. A
+ * message shorter than a block thus costs a single call into the
+ * library, to the block transform or permutation of the dispatched
+ * backend. Link with libhashing as usual.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ripemd160.h"
+#include "sha2.h"
+#include "sha3.h"
+
+static inline uint64_t myc_inline_load64_le(const unsigned char *p)
+{
+    return  (uint64_t) p[0]        | ((uint64_t) p[1] <<  8)
+         | ((uint64_t) p[2] << 16) | ((uint64_t) p[3] << 24)
+         | ((uint64_t) p[4] << 32) | ((uint64_t) p[5] << 40)
+         | ((uint64_t) p[6] << 48) | ((uint64_t) p[7] << 56);
+}
+
+static inline void myc_inline_store32_be(unsigned char *p, uint32_t x)
+{
+    p[0] = (unsigned char) (x >> 24);
+    p[1] = (unsigned char) (x >> 16);
+    p[2] = (unsigned char) (x >>  8);
+    p[3] = (unsigned char) (x      );
+}
+
+static inline void myc_inline_store32_le(unsigned char *p, uint32_t x)
+{
+    p[0] = (unsigned char) (x      );
+    p[1] = (unsigned char) (x >>  8);
+    p[2] = (unsigned char) (x >> 16);
+    p[3] = (unsigned char) (x >> 24);
+}
+
+static inline void myc_inline_store64_le(unsigned char *p, uint64_t x)
+{
+    myc_inline_store32_le(p, (uint32_t) x);
+    myc_inline_store32_le(p + 4, (uint32_t) (x >> 32));
+}
+
+/*
+ * Copy the last len % 64 bytes of a Merkle-Damgard message to block and
+ * pad them with the 64-bit bit count, big-endian for SHA-256 and
+ * little-endian for RIPEMD-160. Returns the number of padded blocks.
+ */
+static inline size_t myc_inline_md_pad(unsigned char *block,
+                                       const unsigned char *message,
+                                       size_t len, int little_endian)
+{
+    size_t rem = len % 64;
+    size_t block_nb = rem < 56 ? 1 : 2;
+    uint64_t bits = (uint64_t) len << 3;
+    unsigned char *end = block + block_nb * 64;
+    int i;
+
+    /* an empty message may be NULL */
+    if (rem != 0)
+        memcpy(block, message + len - rem, rem);
+    block[rem] = 0x80;
+    memset(block + rem + 1, 0, block_nb * 64 - rem - 9);
+    for (i = 0; i < 8; i++) {
+        if (little_endian)
+            end[i - 8] = (unsigned char) (bits >> (8 * i));
+        else
+            end[-1 - i] = (unsigned char) (bits >> (8 * i));
+    }
+
+    return block_nb;
+}
+
+static inline void myc_sha256_inline(const unsigned char *message,
+                                     size_t len, unsigned char *digest)
+{
+    uint32 h[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    unsigned char block[2 * MYC_SHA256_BLOCK_SIZE];
+    size_t block_nb;
+
+    if (len >= MYC_SHA256_BLOCK_SIZE)
+        myc_sha256_transform(h, message, len / MYC_SHA256_BLOCK_SIZE);
+    block_nb = myc_inline_md_pad(block, message, len, 0);
+    myc_sha256_transform(h, block, block_nb);
+
+    /* unrolled by hand, the compiler merges each word into one store */
+    myc_inline_store32_be(digest +  0, h[0]);
+    myc_inline_store32_be(digest +  4, h[1]);
+    myc_inline_store32_be(digest +  8, h[2]);
+    myc_inline_store32_be(digest + 12, h[3]);
+    myc_inline_store32_be(digest + 16, h[4]);
+    myc_inline_store32_be(digest + 20, h[5]);
+    myc_inline_store32_be(digest + 24, h[6]);
+    myc_inline_store32_be(digest + 28, h[7]);
+}
+
+static inline void myc_ripemd160_inline(const uint8_t *msg, size_t len,
+                                        uint8_t *digest)
+{
+    uint32_t h[5] = {
+        0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0
+    };
+    uint8_t block[2 * MYC_RIPEMD160_BLOCK_LENGTH];
+    size_t block_nb;
+
+    if (len >= MYC_RIPEMD160_BLOCK_LENGTH)
+        myc_ripemd160_transform(h, msg, len / MYC_RIPEMD160_BLOCK_LENGTH);
+    block_nb = myc_inline_md_pad(block, msg, len, 1);
+    myc_ripemd160_transform(h, block, block_nb);
+
+    myc_inline_store32_le(digest +  0, h[0]);
+    myc_inline_store32_le(digest +  4, h[1]);
+    myc_inline_store32_le(digest +  8, h[2]);
+    myc_inline_store32_le(digest + 12, h[3]);
+    myc_inline_store32_le(digest + 16, h[4]);
+}
+
+/*
+ * Sponge with a digest of whole words shorter than the rate, pad is
+ * 0x06 for SHA3 and 0x01 for Keccak
+ */
+static inline void myc_inline_sponge(const unsigned char *data, size_t len,
+                                     unsigned char *digest, size_t rate,
+                                     size_t digest_size, unsigned char pad)
+{
+    uint64_t state[25] = { 0 };
+    unsigned char block[MYC_SHAKE128_BLOCK_LENGTH];
+    size_t i;
+
+    for (; len >= rate; len -= rate, data += rate) {
+        for (i = 0; i < rate / 8; i++) {
+            state[i] ^= myc_inline_load64_le(data + i * 8);
+        }
+        myc_sha3_permute(state);
+    }
+
+    if (len != 0)
+        memcpy(block, data, len);
+    memset(block + len, 0, rate - len);
+    block[len] |= pad;
+    block[rate - 1] |= 0x80;
+    for (i = 0; i < rate / 8; i++) {
+        state[i] ^= myc_inline_load64_le(block + i * 8);
+    }
+    myc_sha3_permute(state);
+
+    for (i = 0; i < digest_size / 8; i++) {
+        myc_inline_store64_le(digest + i * 8, state[i]);
+    }
+}
+
+static inline void myc_sha3_256_inline(const unsigned char *data, size_t len,
+                                       unsigned char *digest)
+{
+    myc_inline_sponge(data, len, digest, MYC_SHA3_256_BLOCK_LENGTH,
+                      MYC_SHA3_256_DIGEST_LENGTH, 0x06);
+}
+
+static inline void myc_keccak_256_inline(const unsigned char *data,
+                                         size_t len, unsigned char *digest)
+{
+    myc_inline_sponge(data, len, digest, MYC_SHA3_256_BLOCK_LENGTH,
+                      MYC_SHA3_256_DIGEST_LENGTH, 0x01);
+}
+
+#endif /* MYC_HASHING_INLINE_H */
@@ -40,6 +40,10 @@
 extern "C" {
 #endif
 
+/*
+ * HMAC contexts hold SHA-2 contexts and have their alignment, see
+ * sha2.h: allocate them with myc_sha2_ctx_alloc() on the heap.
+ */
 typedef struct {
     myc_sha224_ctx ctx_inside;
     myc_sha224_ctx ctx_outside;
@@ -89,47 +93,55 @@ typedef struct {
 } myc_hmac_sha512_ctx;
 
 void myc_hmac_sha224_init(myc_hmac_sha224_ctx *ctx, const unsigned char *key,
-                      unsigned int key_size);
+                      size_t key_size);
 void myc_hmac_sha224_reinit(myc_hmac_sha224_ctx *ctx);
 void myc_hmac_sha224_update(myc_hmac_sha224_ctx *ctx, const unsigned char *message,
-                        unsigned int message_len);
+                        size_t message_len);
+void myc_hmac_sha224_updatev(myc_hmac_sha224_ctx *ctx, const struct iovec *iov,
+                             int cnt);
 void myc_hmac_sha224_final(myc_hmac_sha224_ctx *ctx, unsigned char *mac,
                        unsigned int mac_size);
-void myc_hmac_sha224(const unsigned char *key, unsigned int key_size,
-                 const unsigned char *message, unsigned int message_len,
+void myc_hmac_sha224(const unsigned char *key, size_t key_size,
+                 const unsigned char *message, size_t message_len,
                  unsigned char *mac, unsigned mac_size);
 
 void myc_hmac_sha256_init(myc_hmac_sha256_ctx *ctx, const unsigned char *key,
-                      unsigned int key_size);
+                      size_t key_size);
 void myc_hmac_sha256_reinit(myc_hmac_sha256_ctx *ctx);
 void myc_hmac_sha256_update(myc_hmac_sha256_ctx *ctx, const unsigned char *message,
-                        unsigned int message_len);
+                        size_t message_len);
+void myc_hmac_sha256_updatev(myc_hmac_sha256_ctx *ctx, const struct iovec *iov,
+                             int cnt);
 void myc_hmac_sha256_final(myc_hmac_sha256_ctx *ctx, unsigned char *mac,
                        unsigned int mac_size);
-void myc_hmac_sha256(const unsigned char *key, unsigned int key_size,
-                 const unsigned char *message, unsigned int message_len,
+void myc_hmac_sha256(const unsigned char *key, size_t key_size,
+                 const unsigned char *message, size_t message_len,
                  unsigned char *mac, unsigned mac_size);
 
 void myc_hmac_sha384_init(myc_hmac_sha384_ctx *ctx, const unsigned char *key,
-                      unsigned int key_size);
+                      size_t key_size);
 void myc_hmac_sha384_reinit(myc_hmac_sha384_ctx *ctx);
 void myc_hmac_sha384_update(myc_hmac_sha384_ctx *ctx, const unsigned char *message,
-                        unsigned int message_len);
+                        size_t message_len);
+void myc_hmac_sha384_updatev(myc_hmac_sha384_ctx *ctx, const struct iovec *iov,
+                             int cnt);
 void myc_hmac_sha384_final(myc_hmac_sha384_ctx *ctx, unsigned char *mac,
                        unsigned int mac_size);
-void myc_hmac_sha384(const unsigned char *key, unsigned int key_size,
-                 const unsigned char *message, unsigned int message_len,
+void myc_hmac_sha384(const unsigned char *key, size_t key_size,
+                 const unsigned char *message, size_t message_len,
                  unsigned char *mac, unsigned mac_size);
 
 void myc_hmac_sha512_init(myc_hmac_sha512_ctx *ctx, const unsigned char *key,
-                      unsigned int key_size);
+                      size_t key_size);
 void myc_hmac_sha512_reinit(myc_hmac_sha512_ctx *ctx);
 void myc_hmac_sha512_update(myc_hmac_sha512_ctx *ctx, const unsigned char *message,
-                        unsigned int message_len);
+                        size_t message_len);
+void myc_hmac_sha512_updatev(myc_hmac_sha512_ctx *ctx, const struct iovec *iov,
+                             int cnt);
 void myc_hmac_sha512_final(myc_hmac_sha512_ctx *ctx, unsigned char *mac,
                        unsigned int mac_size);
-void myc_hmac_sha512(const unsigned char *key, unsigned int key_size,
-                 const unsigned char *message, unsigned int message_len,
+void myc_hmac_sha512(const unsigned char *key, size_t key_size,
+                 const unsigned char *message, size_t message_len,
                  unsigned char *mac, unsigned mac_size);
 
 #ifdef __cplusplus
@@ -95,6 +95,8 @@ void myc_hmac_sha3_224_init(myc_hmac_sha3_224_ctx *ctx, const unsigned char *key
 void myc_hmac_sha3_224_reinit(myc_hmac_sha3_224_ctx *ctx);
 void myc_hmac_sha3_224_update(myc_hmac_sha3_224_ctx *ctx, const unsigned char *message,
                         unsigned int message_len);
+void myc_hmac_sha3_224_updatev(myc_hmac_sha3_224_ctx *ctx, const struct iovec *iov,
+                               int cnt);
 void myc_hmac_sha3_224_final(myc_hmac_sha3_224_ctx *ctx, unsigned char *mac,
                        unsigned int mac_size);
 void myc_hmac_sha3_224(const unsigned char *key, unsigned int key_size,
@@ -106,6 +108,8 @@ void myc_hmac_sha3_256_init(myc_hmac_sha3_256_ctx *ctx, const unsigned char *key
 void myc_hmac_sha3_256_reinit(myc_hmac_sha3_256_ctx *ctx);
 void myc_hmac_sha3_256_update(myc_hmac_sha3_256_ctx *ctx, const unsigned char *message,
                         unsigned int message_len);
+void myc_hmac_sha3_256_updatev(myc_hmac_sha3_256_ctx *ctx, const struct iovec *iov,
+                               int cnt);
 void myc_hmac_sha3_256_final(myc_hmac_sha3_256_ctx *ctx, unsigned char *mac,
                        unsigned int mac_size);
 void myc_hmac_sha3_256(const unsigned char *key, unsigned int key_size,
@@ -117,6 +121,8 @@ void myc_hmac_sha3_384_init(myc_hmac_sha3_384_ctx *ctx, const unsigned char *key
 void myc_hmac_sha3_384_reinit(myc_hmac_sha3_384_ctx *ctx);
 void myc_hmac_sha3_384_update(myc_hmac_sha3_384_ctx *ctx, const unsigned char *message,
                         unsigned int message_len);
+void myc_hmac_sha3_384_updatev(myc_hmac_sha3_384_ctx *ctx, const struct iovec *iov,
+                               int cnt);
 void myc_hmac_sha3_384_final(myc_hmac_sha3_384_ctx *ctx, unsigned char *mac,
                        unsigned int mac_size);
 void myc_hmac_sha3_384(const unsigned char *key, unsigned int key_size,
@@ -128,6 +134,8 @@ void myc_hmac_sha3_512_init(myc_hmac_sha3_512_ctx *ctx, const unsigned char *key
 void myc_hmac_sha3_512_reinit(myc_hmac_sha3_512_ctx *ctx);
 void myc_hmac_sha3_512_update(myc_hmac_sha3_512_ctx *ctx, const unsigned char *message,
                         unsigned int message_len);
+void myc_hmac_sha3_512_updatev(myc_hmac_sha3_512_ctx *ctx, const struct iovec *iov,
+                               int cnt);
 void myc_hmac_sha3_512_final(myc_hmac_sha3_512_ctx *ctx, unsigned char *mac,
                        unsigned int mac_size);
 void myc_hmac_sha3_512(const unsigned char *key, unsigned int key_size,
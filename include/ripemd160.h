@@ -1,10 +1,15 @@
 #ifndef __MYCRIPEMD160_H__
 #define __MYCRIPEMD160_H__
 
+#include <stddef.h>
 #include <stdint.h>
 
 #define MYC_RIPEMD160_BLOCK_LENGTH 64
 #define MYC_RIPEMD160_DIGEST_LENGTH 20
+#define MYC_RIPEMD160_STATE_SIZE (2 + 8 + 20 + MYC_RIPEMD160_BLOCK_LENGTH)
+
+/* Fragments for myc_ripemd160_Updatev(), from <sys/uio.h> */
+struct iovec;
 
 #ifdef __cplusplus
 extern "C" {
@@ -18,11 +23,51 @@ typedef struct _MYC_RIPEMD160_CTX {
 
 void myc_ripemd160_Init(MYC_RIPEMD160_CTX *ctx);
 void myc_ripemd160_Update(MYC_RIPEMD160_CTX *ctx, const uint8_t *input, uint32_t ilen);
+void myc_ripemd160_Updatev(MYC_RIPEMD160_CTX *ctx, const struct iovec *iov, int cnt);
 void myc_ripemd160_Final(MYC_RIPEMD160_CTX *ctx,
                      uint8_t output[MYC_RIPEMD160_DIGEST_LENGTH]);
+/* Digest of the input so far, the context can still be updated */
+void myc_ripemd160_peek(const MYC_RIPEMD160_CTX *ctx,
+                        uint8_t output[MYC_RIPEMD160_DIGEST_LENGTH]);
 void myc_ripemd160(const uint8_t *msg, uint32_t msg_len,
                uint8_t hash[MYC_RIPEMD160_DIGEST_LENGTH]);
 
+/*
+ * Run the RIPEMD-160 block transform of the dispatched backend over
+ * block_nb blocks of 64 bytes, state being the 5-word chaining state.
+ */
+void myc_ripemd160_transform(uint32_t *state, const uint8_t *blocks,
+                             size_t block_nb);
+
+/*
+ * Save the state of a context to MYC_RIPEMD160_STATE_SIZE portable
+ * bytes and restore it. Import returns -1 if the bytes are not a
+ * RIPEMD-160 state.
+ */
+void myc_ripemd160_export_state(const MYC_RIPEMD160_CTX *ctx,
+                                uint8_t state[MYC_RIPEMD160_STATE_SIZE]);
+int myc_ripemd160_import_state(MYC_RIPEMD160_CTX *ctx,
+                               const uint8_t state[MYC_RIPEMD160_STATE_SIZE]);
+
+/*
+ * Hash count independent messages, message n of lens[n] bytes giving
+ * the MYC_RIPEMD160_DIGEST_LENGTH bytes at digests + n * 20. Uses the
+ * multi-buffer transforms when the CPU has them.
+ */
+void myc_ripemd160_batch(const uint8_t **messages, const size_t *lens,
+                         size_t count, uint8_t *digests);
+
+/*
+ * Hash the count values of a column, as myc_sha256_column() and
+ * myc_sha256_column_fixed() do.
+ */
+void myc_ripemd160_column(const uint8_t *data, const int64_t *offsets,
+                          size_t count, uint8_t *digests,
+                          unsigned int threads);
+void myc_ripemd160_column_fixed(const uint8_t *data, size_t width,
+                                size_t count, uint8_t *digests,
+                                unsigned int threads);
+
 #ifdef __cplusplus
 }
 #endif
@@ -34,6 +34,9 @@
 #ifndef MYC_SHA2_H
 #define MYC_SHA2_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 #define MYC_SHA224_DIGEST_SIZE ( 224 / 8)
 #define MYC_SHA256_DIGEST_SIZE ( 256 / 8)
 #define MYC_SHA384_DIGEST_SIZE ( 384 / 8)
@@ -44,6 +47,12 @@
 #define MYC_SHA384_BLOCK_SIZE  MYC_SHA512_BLOCK_SIZE
 #define MYC_SHA224_BLOCK_SIZE  MYC_SHA256_BLOCK_SIZE
 
+/* Exported states: header, length, chaining value and one block */
+#define MYC_SHA256_STATE_SIZE  (2 +  8 + 32 + MYC_SHA256_BLOCK_SIZE)
+#define MYC_SHA512_STATE_SIZE  (2 + 16 + 64 + MYC_SHA512_BLOCK_SIZE)
+#define MYC_SHA224_STATE_SIZE  MYC_SHA256_STATE_SIZE
+#define MYC_SHA384_STATE_SIZE  MYC_SHA512_STATE_SIZE
+
 #ifndef MYC_SHA2_TYPES
 #define MYC_SHA2_TYPES
 typedef unsigned char uint8;
@@ -51,55 +60,196 @@ typedef unsigned int  uint32;
 typedef unsigned long long uint64;
 #endif
 
+/*
+ * Fragments for the *_updatev() functions, from <sys/uio.h>. Updating
+ * a context with cnt fragments is the same as updating it with each
+ * fragment in turn.
+ */
+struct iovec;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/*
+ * Layout version of the contexts below, changed whenever their size or
+ * fields change. myc_sha2_ctx_version() returns the version the library
+ * was built with, so that a program can check it was compiled against
+ * the same layout.
+ */
+#define MYC_SHA2_CTX_VERSION 2
+
+#define MYC_SHA256_CTX_SIZE 128
+#define MYC_SHA512_CTX_SIZE 256
+
+#define MYC_SHA2_CTX_ALIGNMENT 64
+
+#if defined(_MSC_VER)
+#define MYC_SHA2_CTX_ALIGN __declspec(align(MYC_SHA2_CTX_ALIGNMENT))
+#else
+#define MYC_SHA2_CTX_ALIGN __attribute__((aligned(MYC_SHA2_CTX_ALIGNMENT)))
+#endif
+
+/*
+ * Contexts start on a cache line with the chaining state, followed by
+ * tot_len, the bytes hashed so far on 64 bits for SHA-224/256 and on
+ * 128 bits (low word first) for SHA-384/512, and by the len bytes of
+ * the one block being filled. Contexts in an array never share a cache
+ * line.
+ *
+ * The alignment is part of the types: a context, or a structure holding
+ * one, must start on a multiple of MYC_SHA2_CTX_ALIGNMENT bytes, as the
+ * compiler may access it with aligned vector instructions. Declared
+ * contexts are placed so, but a plain malloc() or a packed structure
+ * may not be. Use myc_sha2_ctx_alloc(sizeof(ctx)) and
+ * myc_sha2_ctx_free() for heap contexts.
+ */
 typedef struct {
-    unsigned int tot_len;
+    MYC_SHA2_CTX_ALIGN uint32 h[8];
+    uint64 tot_len;
     unsigned int len;
-    unsigned char block[2 * MYC_SHA256_BLOCK_SIZE];
-    uint32 h[8];
+    unsigned char block[MYC_SHA256_BLOCK_SIZE];
 } myc_sha256_ctx;
 
 typedef struct {
-    unsigned int tot_len;
+    MYC_SHA2_CTX_ALIGN uint64 h[8];
+    uint64 tot_len[2];
     unsigned int len;
-    unsigned char block[2 * MYC_SHA512_BLOCK_SIZE];
-    uint64 h[8];
+    unsigned char block[MYC_SHA512_BLOCK_SIZE];
 } myc_sha512_ctx;
 
 typedef myc_sha512_ctx myc_sha384_ctx;
 typedef myc_sha256_ctx myc_sha224_ctx;
 
+unsigned int myc_sha2_ctx_version(void);
+
+/* Memory aligned for a SHA-2 or HMAC-SHA-2 context, NULL when out */
+void *myc_sha2_ctx_alloc(size_t size);
+void myc_sha2_ctx_free(void *ctx);
+
+/*
+ * The *_peek() functions write the digest of the input so far, like
+ * *_final(), but leave the context as it is so that it can still be
+ * updated.
+ */
 void myc_sha224_init(myc_sha224_ctx *ctx);
 void myc_sha224_update(myc_sha224_ctx *ctx, const unsigned char *message,
-                   unsigned int len);
+                   size_t len);
+void myc_sha224_updatev(myc_sha224_ctx *ctx, const struct iovec *iov, int cnt);
 void myc_sha224_final(myc_sha224_ctx *ctx, unsigned char *digest);
-void myc_sha224(const unsigned char *message, unsigned int len,
+void myc_sha224_peek(const myc_sha224_ctx *ctx, unsigned char *digest);
+void myc_sha224(const unsigned char *message, size_t len,
             unsigned char *digest);
+void myc_sha224_batch(const unsigned char **messages, const size_t *lens,
+                      size_t count, unsigned char *digests);
 
 void myc_sha256_init(myc_sha256_ctx * ctx);
 void myc_sha256_update(myc_sha256_ctx *ctx, const unsigned char *message,
-                   unsigned int len);
+                   size_t len);
+void myc_sha256_updatev(myc_sha256_ctx *ctx, const struct iovec *iov, int cnt);
 void myc_sha256_final(myc_sha256_ctx *ctx, unsigned char *digest);
-void myc_sha256(const unsigned char *message, unsigned int len,
+void myc_sha256_peek(const myc_sha256_ctx *ctx, unsigned char *digest);
+void myc_sha256(const unsigned char *message, size_t len,
             unsigned char *digest);
 
+/*
+ * Run the SHA-256 block transform of the dispatched backend over
+ * block_nb blocks of 64 bytes, h being the 8-word chaining state.
+ */
+void myc_sha256_transform(uint32 *h, const unsigned char *blocks,
+                          size_t block_nb);
+
+/*
+ * Hash count independent messages, digest n is written at
+ * digests + n * MYC_SHA256_DIGEST_SIZE (MYC_SHA224_DIGEST_SIZE for
+ * SHA-224). Uses the multi-buffer transforms when they are faster than
+ * hashing one message at a time.
+ */
+void myc_sha256_batch(const unsigned char **messages, const size_t *lens,
+                      size_t count, unsigned char *digests);
+
 void myc_sha384_init(myc_sha384_ctx *ctx);
 void myc_sha384_update(myc_sha384_ctx *ctx, const unsigned char *message,
-                   unsigned int len);
+                   size_t len);
+void myc_sha384_updatev(myc_sha384_ctx *ctx, const struct iovec *iov, int cnt);
 void myc_sha384_final(myc_sha384_ctx *ctx, unsigned char *digest);
-void myc_sha384(const unsigned char *message, unsigned int len,
+void myc_sha384_peek(const myc_sha384_ctx *ctx, unsigned char *digest);
+void myc_sha384(const unsigned char *message, size_t len,
             unsigned char *digest);
+void myc_sha384_batch(const unsigned char **messages, const size_t *lens,
+                      size_t count, unsigned char *digests);
 
 void myc_sha512_init(myc_sha512_ctx *ctx);
 void myc_sha512_update(myc_sha512_ctx *ctx, const unsigned char *message,
-                   unsigned int len);
+                   size_t len);
+void myc_sha512_updatev(myc_sha512_ctx *ctx, const struct iovec *iov, int cnt);
 void myc_sha512_final(myc_sha512_ctx *ctx, unsigned char *digest);
-void myc_sha512(const unsigned char *message, unsigned int len,
+void myc_sha512_peek(const myc_sha512_ctx *ctx, unsigned char *digest);
+void myc_sha512(const unsigned char *message, size_t len,
             unsigned char *digest);
 
+/* Same as myc_sha256_batch() with MYC_SHA512/384_DIGEST_SIZE digests */
+void myc_sha512_batch(const unsigned char **messages, const size_t *lens,
+                      size_t count, unsigned char *digests);
+
+/*
+ * Save the state of a context to MYC_SHA*_STATE_SIZE bytes, and restore
+ * it, possibly in another process or on another host. The bytes hold a
+ * format version, the algorithm, the message length, the chaining value
+ * and the partial block. Import returns -1, leaving the context
+ * untouched, if the bytes are not a state of that algorithm.
+ */
+void myc_sha224_export_state(const myc_sha224_ctx *ctx,
+                             unsigned char state[MYC_SHA224_STATE_SIZE]);
+int myc_sha224_import_state(myc_sha224_ctx *ctx,
+                            const unsigned char state[MYC_SHA224_STATE_SIZE]);
+void myc_sha256_export_state(const myc_sha256_ctx *ctx,
+                             unsigned char state[MYC_SHA256_STATE_SIZE]);
+int myc_sha256_import_state(myc_sha256_ctx *ctx,
+                            const unsigned char state[MYC_SHA256_STATE_SIZE]);
+void myc_sha384_export_state(const myc_sha384_ctx *ctx,
+                             unsigned char state[MYC_SHA384_STATE_SIZE]);
+int myc_sha384_import_state(myc_sha384_ctx *ctx,
+                            const unsigned char state[MYC_SHA384_STATE_SIZE]);
+void myc_sha512_export_state(const myc_sha512_ctx *ctx,
+                             unsigned char state[MYC_SHA512_STATE_SIZE]);
+int myc_sha512_import_state(myc_sha512_ctx *ctx,
+                            const unsigned char state[MYC_SHA512_STATE_SIZE]);
+
+/*
+ * Hash the count values of a column stored in one data buffer, digest
+ * n being written at digests + n * digest size. With *_column(), value
+ * n is the bytes from data + offsets[n] to data + offsets[n + 1], as in
+ * Arrow large binary columns. With *_column_fixed(), it is the width
+ * bytes at data + n * width. Values are hashed with the batch hashing,
+ * and columns of many thousands of values are split across up to
+ * threads threads when the library is built with them.
+ */
+void myc_sha224_column(const unsigned char *data, const int64_t *offsets,
+                       size_t count, unsigned char *digests,
+                       unsigned int threads);
+void myc_sha224_column_fixed(const unsigned char *data, size_t width,
+                             size_t count, unsigned char *digests,
+                             unsigned int threads);
+void myc_sha256_column(const unsigned char *data, const int64_t *offsets,
+                       size_t count, unsigned char *digests,
+                       unsigned int threads);
+void myc_sha256_column_fixed(const unsigned char *data, size_t width,
+                             size_t count, unsigned char *digests,
+                             unsigned int threads);
+void myc_sha384_column(const unsigned char *data, const int64_t *offsets,
+                       size_t count, unsigned char *digests,
+                       unsigned int threads);
+void myc_sha384_column_fixed(const unsigned char *data, size_t width,
+                             size_t count, unsigned char *digests,
+                             unsigned int threads);
+void myc_sha512_column(const unsigned char *data, const int64_t *offsets,
+                       size_t count, unsigned char *digests,
+                       unsigned int threads);
+void myc_sha512_column_fixed(const unsigned char *data, size_t width,
+                             size_t count, unsigned char *digests,
+                             unsigned int threads);
+
 #ifdef __cplusplus
 }
 #endif
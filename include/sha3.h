@@ -23,6 +23,9 @@
 #include <stdint.h>
 #include <stddef.h>
 
+/* Fragments for myc_sha3_Updatev(), from <sys/uio.h> */
+struct iovec;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -38,6 +41,8 @@ extern "C" {
 #define MYC_SHA3_256_BLOCK_LENGTH   136
 #define MYC_SHA3_384_BLOCK_LENGTH   104
 #define MYC_SHA3_512_BLOCK_LENGTH   72
+#define MYC_SHAKE128_BLOCK_LENGTH   168
+#define MYC_SHAKE256_BLOCK_LENGTH   136
 
 #define MYC_SHA3_224_DIGEST_LENGTH  myc_sha3_224_hash_size
 #define MYC_SHA3_256_DIGEST_LENGTH  myc_sha3_256_hash_size
@@ -51,9 +56,7 @@ typedef struct _MYC_SHA3_CTX
 {
 	/* 1600 bits algorithm hashing state */
 	uint64_t hash[myc_sha3_max_permutation_size];
-	/* 1536-bit buffer for leftovers */
-	uint64_t message[myc_sha3_max_rate_in_qwords];
-	/* count of bytes in the message[] buffer */
+	/* count of bytes of the current block already xored into hash[] */
 	unsigned rest;
 	/* size of a message block processed at once */
 	unsigned block_size;
@@ -66,7 +69,33 @@ void myc_sha3_256_Init(MYC_SHA3_CTX *ctx);
 void myc_sha3_384_Init(MYC_SHA3_CTX *ctx);
 void myc_sha3_512_Init(MYC_SHA3_CTX *ctx);
 void myc_sha3_Update(MYC_SHA3_CTX *ctx, const unsigned char* msg, size_t size);
+void myc_sha3_Updatev(MYC_SHA3_CTX *ctx, const struct iovec* iov, int cnt);
 void myc_sha3_Final(MYC_SHA3_CTX *ctx, unsigned char* result);
+/* Digest of the input so far, the context can still be updated */
+void myc_sha3_peek(const MYC_SHA3_CTX *ctx, unsigned char* result);
+
+/* SHAKE extendable-output functions, any number of bytes may be read */
+void myc_shake128_Init(MYC_SHA3_CTX *ctx);
+void myc_shake256_Init(MYC_SHA3_CTX *ctx);
+#define myc_shake_Update myc_sha3_Update
+#define myc_shake_Updatev myc_sha3_Updatev
+#define myc_shake_export_state myc_sha3_export_state
+#define myc_shake_import_state myc_sha3_import_state
+void myc_shake_Final(MYC_SHA3_CTX *ctx, unsigned char* result, size_t length);
+void myc_shake_peek(const MYC_SHA3_CTX *ctx, unsigned char* result,
+                    size_t length);
+
+/*
+ * Save the state of a SHA3, SHAKE or Keccak context to
+ * MYC_SHA3_STATE_SIZE portable bytes and restore it. Export returns -1
+ * for a context that was finalized, import if the bytes are not a state
+ * of a Keccak sponge of a known rate. Both return 0 on success.
+ */
+#define MYC_SHA3_STATE_SIZE (4 + 8 * myc_sha3_max_permutation_size)
+int myc_sha3_export_state(const MYC_SHA3_CTX *ctx,
+                          unsigned char state[MYC_SHA3_STATE_SIZE]);
+int myc_sha3_import_state(MYC_SHA3_CTX *ctx,
+                          const unsigned char state[MYC_SHA3_STATE_SIZE]);
 
 #if USE_KECCAK
 #define myc_keccak_224_Init myc_sha3_224_Init
@@ -74,15 +103,87 @@ void myc_sha3_Final(MYC_SHA3_CTX *ctx, unsigned char* result);
 #define myc_keccak_384_Init myc_sha3_384_Init
 #define myc_keccak_512_Init myc_sha3_512_Init
 #define myc_keccak_Update myc_sha3_Update
+#define myc_keccak_Updatev myc_sha3_Updatev
+#define myc_keccak_export_state myc_sha3_export_state
+#define myc_keccak_import_state myc_sha3_import_state
 void myc_keccak_Final(MYC_SHA3_CTX *ctx, unsigned char* result);
+void myc_keccak_peek(const MYC_SHA3_CTX *ctx, unsigned char* result);
 void myc_keccak_256(const unsigned char* data, size_t len, unsigned char* digest);
 void myc_keccak_512(const unsigned char* data, size_t len, unsigned char* digest);
+void myc_keccak_256_batch(const unsigned char** messages, const size_t* lens,
+                          size_t count, unsigned char* digests);
+void myc_keccak_512_batch(const unsigned char** messages, const size_t* lens,
+                          size_t count, unsigned char* digests);
+void myc_keccak_256_column(const unsigned char* data, const int64_t* offsets,
+                           size_t count, unsigned char* digests,
+                           unsigned int threads);
+void myc_keccak_256_column_fixed(const unsigned char* data, size_t width,
+                                 size_t count, unsigned char* digests,
+                                 unsigned int threads);
+void myc_keccak_512_column(const unsigned char* data, const int64_t* offsets,
+                           size_t count, unsigned char* digests,
+                           unsigned int threads);
+void myc_keccak_512_column_fixed(const unsigned char* data, size_t width,
+                                 size_t count, unsigned char* digests,
+                                 unsigned int threads);
 #endif
 
 void myc_sha3_224(const unsigned char* data, size_t len, unsigned char* digest);
 void myc_sha3_256(const unsigned char* data, size_t len, unsigned char* digest);
 void myc_sha3_384(const unsigned char* data, size_t len, unsigned char* digest);
 void myc_sha3_512(const unsigned char* data, size_t len, unsigned char* digest);
+void myc_shake128(const unsigned char* data, size_t len,
+                  unsigned char* result, size_t length);
+void myc_shake256(const unsigned char* data, size_t len,
+                  unsigned char* result, size_t length);
+
+/* Keccak-f[1600] permutation of the dispatched backend */
+void myc_sha3_permute(uint64_t state[25]);
+
+/*
+ * Hash count independent messages, digest n is written at
+ * digests + n * MYC_SHA3_*_DIGEST_LENGTH. Several messages are
+ * absorbed and permuted together when the CPU allows it.
+ */
+void myc_sha3_224_batch(const unsigned char** messages, const size_t* lens,
+                        size_t count, unsigned char* digests);
+void myc_sha3_256_batch(const unsigned char** messages, const size_t* lens,
+                        size_t count, unsigned char* digests);
+void myc_sha3_384_batch(const unsigned char** messages, const size_t* lens,
+                        size_t count, unsigned char* digests);
+void myc_sha3_512_batch(const unsigned char** messages, const size_t* lens,
+                        size_t count, unsigned char* digests);
+
+/*
+ * Hash the count values of a column, as myc_sha256_column() and
+ * myc_sha256_column_fixed() do: value n is either the bytes between
+ * data + offsets[n] and data + offsets[n + 1] or the width bytes at
+ * data + n * width.
+ */
+void myc_sha3_224_column(const unsigned char* data, const int64_t* offsets,
+                         size_t count, unsigned char* digests,
+                         unsigned int threads);
+void myc_sha3_224_column_fixed(const unsigned char* data, size_t width,
+                               size_t count, unsigned char* digests,
+                               unsigned int threads);
+void myc_sha3_256_column(const unsigned char* data, const int64_t* offsets,
+                         size_t count, unsigned char* digests,
+                         unsigned int threads);
+void myc_sha3_256_column_fixed(const unsigned char* data, size_t width,
+                               size_t count, unsigned char* digests,
+                               unsigned int threads);
+void myc_sha3_384_column(const unsigned char* data, const int64_t* offsets,
+                         size_t count, unsigned char* digests,
+                         unsigned int threads);
+void myc_sha3_384_column_fixed(const unsigned char* data, size_t width,
+                               size_t count, unsigned char* digests,
+                               unsigned int threads);
+void myc_sha3_512_column(const unsigned char* data, const int64_t* offsets,
+                         size_t count, unsigned char* digests,
+                         unsigned int threads);
+void myc_sha3_512_column_fixed(const unsigned char* data, size_t width,
+                               size_t count, unsigned char* digests,
+                               unsigned int threads);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -0,0 +1,111 @@
+#define USE_KECCAK 1
+#include "ripemd160.h"
+#include "sha2.h"
+#include "sha3.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+#define ROWS 20000
+#define WIDTH 40
+
+typedef void (*column_fn)(const unsigned char *, const int64_t *, size_t,
+                          unsigned char *, unsigned int);
+typedef void (*fixed_fn)(const unsigned char *, size_t, size_t,
+                         unsigned char *, unsigned int);
+typedef void (*oneshot_fn)(const unsigned char *, size_t, unsigned char *);
+
+static unsigned char data[ROWS * 100];
+static int64_t offsets[ROWS + 1];
+static unsigned char digests[ROWS * 64];
+
+static void sha256(const unsigned char *msg, size_t len, unsigned char *digest) {
+    myc_sha256(msg, len, digest);
+}
+
+static void sha512(const unsigned char *msg, size_t len, unsigned char *digest) {
+    myc_sha512(msg, len, digest);
+}
+
+static void ripemd160(const unsigned char *msg, size_t len, unsigned char *digest) {
+    myc_ripemd160(msg, (uint32_t) len, digest);
+}
+
+/**
+Every digest of the column must match the one-shot digest of its value.
+Values are hashed with offsets and with a fixed width, on one thread and
+on four, with a row count large enough to be split.
+*/
+
+static int check(const char *name, const char *mode, unsigned int threads,
+                 oneshot_fn oneshot, const int64_t *offs, size_t width,
+                 int digest_size) {
+    uint8_t digest[64];
+    int failed = 0;
+
+    for (size_t n = 0; n < ROWS; ++n) {
+        const unsigned char *value = offs ? data + offs[n] : data + n * width;
+        size_t len = offs ? (size_t) (offs[n + 1] - offs[n]) : width;
+
+        oneshot(value, len, digest);
+        if (memcmp(digests + n * digest_size, digest, digest_size) != 0)
+            failed = 1;
+    }
+
+    printf("%s_column(%d values, %s, %u threads): %s\n", name, ROWS, mode,
+           threads, failed ? "MISMATCH" : "ok");
+
+    return failed;
+}
+
+static int test(const char *name, column_fn column, fixed_fn fixed,
+                oneshot_fn oneshot, int digest_size) {
+    int failed = 0;
+
+    for (unsigned int threads = 1; threads <= 4; threads += 3) {
+        column(data, offsets, ROWS, digests, threads);
+        failed |= check(name, "offsets", threads, oneshot, offsets, 0,
+                        digest_size);
+
+        fixed(data, WIDTH, ROWS, digests, threads);
+        failed |= check(name, "fixed width", threads, oneshot, NULL, WIDTH,
+                        digest_size);
+    }
+
+    return failed;
+}
+
+/**
+Value n of the offsets column is n % 97 bytes, so lengths cross the
+block boundaries of every algorithm.
+*/
+
+int main() {
+    int failed = 0;
+
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = (unsigned char) (i * 7 + (i >> 8));
+    }
+    offsets[0] = 0;
+    for (size_t n = 0; n < ROWS; ++n) {
+        offsets[n + 1] = offsets[n] + n % 97;
+    }
+
+    printf("Testing column hashing against one-shot hashing:\n");
+
+    failed |= test("sha256", myc_sha256_column, myc_sha256_column_fixed,
+                   sha256, MYC_SHA256_DIGEST_SIZE);
+    failed |= test("sha512", myc_sha512_column, myc_sha512_column_fixed,
+                   sha512, MYC_SHA512_DIGEST_SIZE);
+    failed |= test("sha3_256", myc_sha3_256_column, myc_sha3_256_column_fixed,
+                   myc_sha3_256, MYC_SHA3_256_DIGEST_LENGTH);
+    failed |= test("keccak_256", myc_keccak_256_column,
+                   myc_keccak_256_column_fixed, myc_keccak_256,
+                   MYC_SHA3_256_DIGEST_LENGTH);
+    failed |= test("ripemd160", myc_ripemd160_column,
+                   myc_ripemd160_column_fixed, ripemd160,
+                   MYC_RIPEMD160_DIGEST_LENGTH);
+
+    return failed;
+}
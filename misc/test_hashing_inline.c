@@ -0,0 +1,83 @@
+#define USE_KECCAK 1
+#include "hashing_inline.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+static void print(const uint8_t *data, int length) {
+    for (int i = 0; i < length; ++i) {
+        printf("%02x", data[i]);
+    }
+}
+
+#define MESSAGE_COUNT 100
+
+typedef void (*oneshot_fn)(const unsigned char *, size_t, unsigned char *);
+
+static uint8_t data[MESSAGE_COUNT][4 * MYC_SHA3_256_BLOCK_LENGTH];
+static size_t lens[MESSAGE_COUNT];
+
+static void sha256(const unsigned char *msg, size_t len, unsigned char *digest) {
+    myc_sha256(msg, len, digest);
+}
+
+static void ripemd160(const unsigned char *msg, size_t len, unsigned char *digest) {
+    myc_ripemd160(msg, (uint32_t) len, digest);
+}
+
+/**
+Each message is hashed with the inline function and with the library
+one-shot function and both digests must match.
+*/
+
+static int test(const char *name, oneshot_fn inlined, oneshot_fn oneshot,
+                int digest_size) {
+    uint8_t inline_digest[MYC_SHA3_256_DIGEST_LENGTH];
+    uint8_t digest[MYC_SHA3_256_DIGEST_LENGTH];
+    int failed = 0;
+
+    for (size_t n = 0; n < MESSAGE_COUNT; ++n) {
+        inlined(data[n], lens[n], inline_digest);
+        oneshot(data[n], lens[n], digest);
+
+        printf("%s_inline(%zu bytes): ", name, lens[n]);
+        print(inline_digest, digest_size);
+        if (memcmp(inline_digest, digest, digest_size) != 0) {
+            printf(" MISMATCH");
+            failed = 1;
+        }
+        printf("\n");
+    }
+
+    return failed;
+}
+
+/**
+Message n is n * 5 bytes of (n + i) & 0xff, so lengths cover the one
+and two padding block cases and every rate boundary.
+*/
+
+int main() {
+    int failed = 0;
+
+    for (int n = 0; n < MESSAGE_COUNT; ++n) {
+        lens[n] = (size_t) n * 5;
+        for (size_t i = 0; i < lens[n]; ++i) {
+            data[n][i] = (uint8_t) (n + i);
+        }
+    }
+
+    printf("Testing inline hashing against the library:\n");
+
+    failed |= test("sha256", myc_sha256_inline, sha256,
+                   MYC_SHA256_DIGEST_SIZE);
+    failed |= test("ripemd160", myc_ripemd160_inline, ripemd160,
+                   MYC_RIPEMD160_DIGEST_LENGTH);
+    failed |= test("sha3_256", myc_sha3_256_inline, myc_sha3_256,
+                   MYC_SHA3_256_DIGEST_LENGTH);
+    failed |= test("keccak_256", myc_keccak_256_inline, myc_keccak_256,
+                   MYC_SHA3_256_DIGEST_LENGTH);
+
+    return failed;
+}
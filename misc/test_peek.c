@@ -0,0 +1,147 @@
+#define USE_KECCAK 1
+
+#include "ripemd160.h"
+#include "sha2.h"
+#include "sha3.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+#define MESSAGE_LENGTH 400
+#define STEP 7
+
+static uint8_t message[MESSAGE_LENGTH];
+
+/**
+The message is streamed STEP bytes at a time. After each update the
+peeked digest must be the one-shot digest of the bytes so far, and the
+final digest must be the one of the whole message, so peeking did not
+change the context.
+*/
+
+static int check(const char *name, size_t len, const uint8_t *digest,
+                 const uint8_t *expected, int length) {
+    if (memcmp(digest, expected, length) != 0) {
+        printf("%s after %zu bytes: MISMATCH\n", name, len);
+        return 1;
+    }
+    return 0;
+}
+
+#define TEST_SHA2(name, ctx_type, size)                                 \
+static int test_##name(void) {                                          \
+    uint8_t expected[64], digest[64];                                   \
+    ctx_type ctx;                                                       \
+    int failed = 0;                                                     \
+                                                                        \
+    myc_##name##_init(&ctx);                                            \
+    for (size_t len = 0; len + STEP <= MESSAGE_LENGTH; len += STEP) {   \
+        myc_##name##_update(&ctx, message + len, STEP);                 \
+        myc_##name##_peek(&ctx, digest);                                \
+        myc_##name(message, len + STEP, expected);                      \
+        failed |= check(#name, len + STEP, digest, expected, size);     \
+    }                                                                   \
+    myc_##name##_final(&ctx, digest);                                   \
+    myc_##name(message, MESSAGE_LENGTH / STEP * STEP, expected);        \
+    failed |= check(#name " final", MESSAGE_LENGTH, digest, expected,   \
+                    size);                                              \
+    printf(#name ": %s\n", failed ? "FAILED" : "ok");                   \
+    return failed;                                                      \
+}
+
+TEST_SHA2(sha224, myc_sha224_ctx, MYC_SHA224_DIGEST_SIZE)
+TEST_SHA2(sha256, myc_sha256_ctx, MYC_SHA256_DIGEST_SIZE)
+TEST_SHA2(sha384, myc_sha384_ctx, MYC_SHA384_DIGEST_SIZE)
+TEST_SHA2(sha512, myc_sha512_ctx, MYC_SHA512_DIGEST_SIZE)
+
+static int test_ripemd160(void) {
+    uint8_t expected[MYC_RIPEMD160_DIGEST_LENGTH];
+    uint8_t digest[MYC_RIPEMD160_DIGEST_LENGTH];
+    MYC_RIPEMD160_CTX ctx;
+    int failed = 0;
+
+    myc_ripemd160_Init(&ctx);
+    for (size_t len = 0; len + STEP <= MESSAGE_LENGTH; len += STEP) {
+        myc_ripemd160_Update(&ctx, message + len, STEP);
+        myc_ripemd160_peek(&ctx, digest);
+        myc_ripemd160(message, (uint32_t) (len + STEP), expected);
+        failed |= check("ripemd160", len + STEP, digest, expected,
+                        MYC_RIPEMD160_DIGEST_LENGTH);
+    }
+    myc_ripemd160_Final(&ctx, digest);
+    myc_ripemd160(message, MESSAGE_LENGTH / STEP * STEP, expected);
+    failed |= check("ripemd160 final", MESSAGE_LENGTH, digest, expected,
+                    MYC_RIPEMD160_DIGEST_LENGTH);
+    printf("ripemd160: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
+
+typedef void (*sha3_oneshot)(const unsigned char *, size_t, unsigned char *);
+
+static int test_sha3(const char *name, void (*init)(MYC_SHA3_CTX *),
+                     void (*peek)(const MYC_SHA3_CTX *, unsigned char *),
+                     void (*final)(MYC_SHA3_CTX *, unsigned char *),
+                     sha3_oneshot oneshot, int digest_size) {
+    uint8_t expected[64], digest[64];
+    MYC_SHA3_CTX ctx;
+    int failed = 0;
+
+    init(&ctx);
+    for (size_t len = 0; len + STEP <= MESSAGE_LENGTH; len += STEP) {
+        myc_sha3_Update(&ctx, message + len, STEP);
+        peek(&ctx, digest);
+        oneshot(message, len + STEP, expected);
+        failed |= check(name, len + STEP, digest, expected, digest_size);
+    }
+    final(&ctx, digest);
+    oneshot(message, MESSAGE_LENGTH / STEP * STEP, expected);
+    failed |= check(name, MESSAGE_LENGTH, digest, expected, digest_size);
+    printf("%s: %s\n", name, failed ? "FAILED" : "ok");
+    return failed;
+}
+
+static int test_shake128(void) {
+    uint8_t expected[400], output[400];
+    MYC_SHA3_CTX ctx;
+    int failed = 0;
+
+    myc_shake128_Init(&ctx);
+    for (size_t len = 0; len + STEP <= MESSAGE_LENGTH; len += STEP) {
+        myc_shake_Update(&ctx, message + len, STEP);
+        myc_shake_peek(&ctx, output, sizeof(output));
+        myc_shake128(message, len + STEP, expected, sizeof(expected));
+        failed |= check("shake128", len + STEP, output, expected,
+                        sizeof(output));
+    }
+    printf("shake128: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
+
+int main() {
+    int failed = 0;
+
+    for (size_t i = 0; i < MESSAGE_LENGTH; ++i) {
+        message[i] = (uint8_t) (i * 5 + 17);
+    }
+
+    printf("Testing digest peeks of streamed messages:\n");
+
+    failed |= test_sha224();
+    failed |= test_sha256();
+    failed |= test_sha384();
+    failed |= test_sha512();
+    failed |= test_ripemd160();
+    failed |= test_sha3("sha3_256", myc_sha3_256_Init, myc_sha3_peek,
+                        myc_sha3_Final, myc_sha3_256,
+                        MYC_SHA3_256_DIGEST_LENGTH);
+    failed |= test_sha3("sha3_512", myc_sha3_512_Init, myc_sha3_peek,
+                        myc_sha3_Final, myc_sha3_512,
+                        MYC_SHA3_512_DIGEST_LENGTH);
+    failed |= test_sha3("keccak_256", myc_keccak_256_Init, myc_keccak_peek,
+                        myc_keccak_Final, myc_keccak_256,
+                        MYC_SHA3_256_DIGEST_LENGTH);
+    failed |= test_shake128();
+
+    return failed;
+}
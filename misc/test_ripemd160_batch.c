@@ -0,0 +1,72 @@
+#include "ripemd160.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+static void print(const uint8_t *data, int length) {
+    for (int i = 0; i < length; ++i) {
+        printf("%02x", data[i]);
+    }
+}
+
+#define BATCH_SIZE 100
+
+static uint8_t data[BATCH_SIZE][8 * MYC_RIPEMD160_BLOCK_LENGTH];
+static const uint8_t *messages[BATCH_SIZE];
+static size_t lens[BATCH_SIZE];
+
+/**
+Each message of the batch is hashed with myc_ripemd160() too and both
+digests must match. Batches of count messages are hashed so that both
+small batches and the large ones given to the widest multi-buffer
+transforms are covered.
+*/
+
+static int test(size_t count) {
+    uint8_t digests[BATCH_SIZE * MYC_RIPEMD160_DIGEST_LENGTH];
+    uint8_t digest[MYC_RIPEMD160_DIGEST_LENGTH];
+    int failed = 0;
+
+    myc_ripemd160_batch(messages, lens, count, digests);
+
+    for (size_t n = 0; n < count; ++n) {
+        const uint8_t *batch_digest = digests + n * MYC_RIPEMD160_DIGEST_LENGTH;
+
+        myc_ripemd160(messages[n], (uint32_t) lens[n], digest);
+
+        printf("ripemd160_batch(%zu/%zu, %zu bytes): ", n, count, lens[n]);
+        print(batch_digest, MYC_RIPEMD160_DIGEST_LENGTH);
+        if (memcmp(batch_digest, digest, MYC_RIPEMD160_DIGEST_LENGTH) != 0) {
+            printf(" MISMATCH");
+            failed = 1;
+        }
+        printf("\n");
+    }
+
+    return failed;
+}
+
+/**
+Message n is n * 5 bytes of (n + i) & 0xff, so lengths cover the one
+and two padding block cases and lanes finish at different times.
+*/
+
+int main() {
+    int failed = 0;
+
+    for (int n = 0; n < BATCH_SIZE; ++n) {
+        lens[n] = (size_t) n * 5;
+        for (size_t i = 0; i < lens[n]; ++i) {
+            data[n][i] = (uint8_t) (n + i);
+        }
+        messages[n] = data[n];
+    }
+
+    printf("Testing RIPEMD-160 batch against one-shot hashing:\n");
+
+    failed |= test(37);
+    failed |= test(BATCH_SIZE);
+
+    return failed;
+}
@@ -0,0 +1,93 @@
+#include "sha2.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+static void print(const uint8_t *data, int length) {
+    for (int i = 0; i < length; ++i) {
+        printf("%02x", data[i]);
+    }
+}
+
+#define BATCH_SIZE 100
+
+typedef void (*batch_fn)(const unsigned char **, const size_t *, size_t,
+                         unsigned char *);
+typedef void (*oneshot_fn)(const unsigned char *, size_t,
+                           unsigned char *);
+
+static uint8_t data[BATCH_SIZE][8 * MYC_SHA256_BLOCK_SIZE];
+static const uint8_t *messages[BATCH_SIZE];
+static size_t lens[BATCH_SIZE];
+
+/**
+Each message of the batch is hashed with the one-shot function too
+and both digests must match. Batches of count messages are hashed
+so that both small batches and the large ones given to the widest
+multi-buffer transforms are covered.
+*/
+
+static int test(const char *name, batch_fn batch, oneshot_fn oneshot,
+                int digest_size, size_t count) {
+    uint8_t digests[BATCH_SIZE * MYC_SHA512_DIGEST_SIZE];
+    uint8_t digest[MYC_SHA512_DIGEST_SIZE];
+    int failed = 0;
+
+    batch(messages, lens, count, digests);
+
+    for (size_t n = 0; n < count; ++n) {
+        const uint8_t *batch_digest = digests + n * digest_size;
+
+        oneshot(messages[n], lens[n], digest);
+
+        printf("%s_batch(%zu/%zu, %zu bytes): ", name, n, count, lens[n]);
+        print(batch_digest, digest_size);
+        if (memcmp(batch_digest, digest, digest_size) != 0) {
+            printf(" MISMATCH");
+            failed = 1;
+        }
+        printf("\n");
+    }
+
+    return failed;
+}
+
+/**
+Message n is n * 5 bytes of (n + i) & 0xff, so lengths cover the one
+and two padding block cases and lanes finish at different times.
+*/
+
+int main() {
+    int failed = 0;
+
+    for (int n = 0; n < BATCH_SIZE; ++n) {
+        lens[n] = (size_t) n * 5;
+        for (size_t i = 0; i < lens[n]; ++i) {
+            data[n][i] = (uint8_t) (n + i);
+        }
+        messages[n] = data[n];
+    }
+
+    printf("Testing SHA-2 batch against one-shot hashing:\n");
+
+    failed |= test("sha224", myc_sha224_batch, myc_sha224,
+                   MYC_SHA224_DIGEST_SIZE, 37);
+    failed |= test("sha256", myc_sha256_batch, myc_sha256,
+                   MYC_SHA256_DIGEST_SIZE, 37);
+    failed |= test("sha224", myc_sha224_batch, myc_sha224,
+                   MYC_SHA224_DIGEST_SIZE, BATCH_SIZE);
+    failed |= test("sha256", myc_sha256_batch, myc_sha256,
+                   MYC_SHA256_DIGEST_SIZE, BATCH_SIZE);
+
+    failed |= test("sha384", myc_sha384_batch, myc_sha384,
+                   MYC_SHA384_DIGEST_SIZE, 37);
+    failed |= test("sha512", myc_sha512_batch, myc_sha512,
+                   MYC_SHA512_DIGEST_SIZE, 37);
+    failed |= test("sha384", myc_sha384_batch, myc_sha384,
+                   MYC_SHA384_DIGEST_SIZE, BATCH_SIZE);
+    failed |= test("sha512", myc_sha512_batch, myc_sha512,
+                   MYC_SHA512_DIGEST_SIZE, BATCH_SIZE);
+
+    return failed;
+}
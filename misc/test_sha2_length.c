@@ -0,0 +1,108 @@
+#include "sha2.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+static void print(const uint8_t *data, int length) {
+    for (int i = 0; i < length; ++i) {
+        printf("%02x", data[i]);
+    }
+}
+
+/**
+Streaming gigabytes through the update functions takes too long for a
+test, so the byte counters are set as if that many bytes had been
+hashed already. The message then goes over 2^32 bytes for SHA-224/256
+and over 2^64 bytes for SHA-384/512, and the digests must be the ones
+of the chaining state from init with that length in the padding, as
+given by a reference implementation.
+*/
+
+static uint8_t message[300];
+
+static int report(const char *name, const uint8_t *digest,
+                  const char *expected, int length) {
+    char hex[2 * MYC_SHA512_DIGEST_SIZE + 1];
+
+    for (int i = 0; i < length; ++i) {
+        sprintf(hex + 2 * i, "%02x", digest[i]);
+    }
+
+    printf("%s: ", name);
+    print(digest, length);
+    if (strcmp(hex, expected) != 0) {
+        printf(" MISMATCH\n");
+        return 1;
+    }
+    printf("\n");
+    return 0;
+}
+
+int main() {
+    uint8_t digest[MYC_SHA512_DIGEST_SIZE];
+    myc_sha256_ctx ctx256;
+    myc_sha512_ctx ctx512;
+    int failed = 0;
+
+    for (size_t i = 0; i < sizeof(message); ++i) {
+        message[i] = (uint8_t) (i * 7 + 1);
+    }
+
+    printf("Testing SHA-2 message lengths over the 32 and 64-bit limits:\n");
+
+    myc_sha224_init(&ctx256);
+    ctx256.tot_len = 0xffffffc0;
+    myc_sha224_update(&ctx256, message, 131);
+    myc_sha224_final(&ctx256, digest);
+    failed |= report("sha224(2^32 + 67 bytes)", digest,
+                     "db7c93de66b781736d45535f8c96917e"
+                     "483ab240a9d990e098daeb6c", MYC_SHA224_DIGEST_SIZE);
+
+    myc_sha256_init(&ctx256);
+    ctx256.tot_len = 0xffffffc0;
+    myc_sha256_update(&ctx256, message, 100);
+    myc_sha256_update(&ctx256, message + 100, 31);
+    myc_sha256_final(&ctx256, digest);
+    failed |= report("sha256(2^32 + 67 bytes)", digest,
+                     "c808aac1228fd558e1442b16f65a9218"
+                     "551fe39521897e1047a42e87b1a499c3",
+                     MYC_SHA256_DIGEST_SIZE);
+
+    myc_sha384_init(&ctx512);
+    ctx512.tot_len[0] = 0xffffffffffffff80ULL;
+    myc_sha384_update(&ctx512, message, 259);
+    myc_sha384_final(&ctx512, digest);
+    failed |= report("sha384(2^64 + 131 bytes)", digest,
+                     "5b96fec4d502dca8750dab83797b8e9e"
+                     "65fd96a8e0dd2ced082059b74a2bdc06"
+                     "02c7cd002d34b58819e0a97f10317294",
+                     MYC_SHA384_DIGEST_SIZE);
+
+    myc_sha512_init(&ctx512);
+    ctx512.tot_len[0] = 0xffffffffffffff80ULL;
+    myc_sha512_update(&ctx512, message, 200);
+    myc_sha512_update(&ctx512, message + 200, 59);
+    myc_sha512_final(&ctx512, digest);
+    failed |= report("sha512(2^64 + 131 bytes)", digest,
+                     "4e441a9891d6e20cc394be8618e60212"
+                     "686a177fca1740a27fe2b3766b6fc4f0"
+                     "3b8b7c478c1cbe289116fedbe17cebe9"
+                     "2ccddb98387e139110ba16a08ac23ce4",
+                     MYC_SHA512_DIGEST_SIZE);
+
+    /* the top 3 bits of the byte count end up in the bit count */
+    myc_sha512_init(&ctx512);
+    ctx512.tot_len[0] = 0xffffffffffffff80ULL;
+    ctx512.tot_len[1] = 7;
+    myc_sha512_update(&ctx512, message, 259);
+    myc_sha512_final(&ctx512, digest);
+    failed |= report("sha512(2^67 + 131 bytes)", digest,
+                     "71e3e833899cd289ce990a5ca638516e"
+                     "4ddafffd6d388767f54f3419d3021a48"
+                     "f82486b4ea08a6765bba162f1ecc4645"
+                     "5e21e9c62f28dcc220c2434adad56cfc",
+                     MYC_SHA512_DIGEST_SIZE);
+
+    return failed;
+}
@@ -23,6 +23,8 @@ SHA-3-224	6b4e03423667dbb7 3b6e15454f0eb1ab d4597f9a1b078e3f 5b5a6bc7
 SHA-3-256	a7ffc6f8bf1ed766 51c14756a061d662 f580ff4de43b49fa 82d80a4b80f8434a
 SHA-3-384	0c63a75b845e4f7d 01107d852e4c2485 c51a50aaaa94fc61 995e71bbee983a2a c3713831264adb47 fb6bd1e058d5f004
 SHA-3-512	a69f73cca23a9ac5 c8b567dc185a756e 97c982164fe25859 e0d1dcc1475c80a6 15b2123af1f5f94c 11e3e9402c3ac558 f500199d95b6d3e3 01758586281dcd26
+SHAKE128	7f9c2ba4e88f827d 616045507605853e d73b8093f6efbc88 eb1a6eacfa66ef26
+SHAKE256	46b9dd2b0ba88d13 233b3feb743eeb24 3fcd52ea62b81b82 b50c27646ed5762f d75dc4ddd8c0f200 cb05019d67b592f6 fc821c49479ab486 40292eacb3b7c4be
 
 Input message: "abc", the bit string (0x)616263 of length 24 bits.
 
@@ -31,6 +33,8 @@ SHA-3-224	e642824c3f8cf24a d09234ee7d3c766f c9a3a5168d0c94ad 73b46fdf
 SHA-3-256	3a985da74fe225b2 045c172d6bd390bd 855f086e3e9d525b 46bfe24511431532
 SHA-3-384	ec01498288516fc9 26459f58e2c6ad8d f9b473cb0fc08c25 96da7cf0e49be4b2 98d88cea927ac7f5 39f1edf228376d25
 SHA-3-512	b751850b1a57168a 5693cd924b6b096e 08f621827444f70d 884f5d0240d2712e 10e116e9192af3c9 1a7ec57647e39340 57340b4cf408d5a5 6592f8274eec53f0
+SHAKE128	5881092dd818bf5c f8a3ddb793fbcba7 4097d5c526a6d35f 97b83351940f2cc8
+SHAKE256	483366601360a877 1c6863080cc4114d 8db44530f8f1e1ee 4f94ea37e78b5739 d5a15bef186a5386 c75744c0527e1faa 9f8726e462a12a4f eb06bd8801e751e4
 
 Input message: "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq" (length 448 bits).
 
@@ -39,6 +43,8 @@ SHA-3-224	8a24108b154ada21 c9fd5574494479ba 5c7e7ab76ef264ea d0fcce33
 SHA-3-256	41c0dba2a9d62408 49100376a8235e2c 82e1b9998a999e21 db32dd97496d3376
 SHA-3-384	991c665755eb3a4b 6bbdfb75c78a492e 8c56a22c5c4d7e42 9bfdbc32b9d4ad5a a04a1f076e62fea1 9eef51acd0657c22
 SHA-3-512	04a371e84ecfb5b8 b77cb48610fca818 2dd457ce6f326a0f d3d7ec2f1e91636d ee691fbe0c985302 ba1b0d8dc78c0863 46b533b49c030d99 a27daf1139d6e75e
+SHAKE128	1a96182b50fb8c7e 74e0a707788f55e9 8209b8d91fade8f3 2f8dd5cff7bf21f5
+SHAKE256	4d8c2dd2435a0128 eefbb8c36f6f8713 3a7911e18d979ee1 ae6be5d4fd2e3329 40d8688a4e6a59aa 8060f1f9bc996c05 aca3c696a8b66279 dc672c740bb224ec
 
 Input message: "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu" (length 896 bits).
 
@@ -47,6 +53,8 @@ SHA-3-224	543e6868e1666c1a 643630df77367ae5 a62a85070a51c14c bf665cbc
 SHA-3-256	916f6061fe879741 ca6469b43971dfdb 28b1a32dc36cb325 4e812be27aad1d18
 SHA-3-384	79407d3b5916b59c 3e30b09822974791 c313fb9ecc849e40 6f23592d04f625dc 8c709b98b43b3852 b337216179aa7fc7
 SHA-3-512	afebb2ef542e6579 c50cad06d2e578f9 f8dd6881d7dc824d 26360feebf18a4fa 73e3261122948efc fd492e74e82e2189 ed0fb440d187f382 270cb455f21dd185
+SHAKE128	7b6df6ff181173b6 d7898d7ff63fb07b 7c237daf471a5ae5 602adbccef9ccf4b
+SHAKE256	98be04516c04cc73 593fef3ed0352ea9 f6443942d6950e29 a372a681c3deaf45 35423709b0284394 8684e029010badcc 0acd8303fc85fdad 3eabf4f78cae1656
 */
 
 struct testVector testData[4] = {
@@ -112,5 +120,31 @@ int main() {
         printf("\n");
     }
 
+    printf("Testing SHAKE128 against test vectors:\n");
+
+    for (int i = 0; i < 4; ++i) {
+        const char *input = testData[i].input;
+        const int input_len = testData[i].input_len;
+
+        myc_shake128((const uint8_t *)input, input_len, digest, 32);
+
+        printf("shake128(%s): ", input);
+        print((const uint8_t *)digest, 32);
+        printf("\n");
+    }
+
+    printf("Testing SHAKE256 against test vectors:\n");
+
+    for (int i = 0; i < 4; ++i) {
+        const char *input = testData[i].input;
+        const int input_len = testData[i].input_len;
+
+        myc_shake256((const uint8_t *)input, input_len, digest, 64);
+
+        printf("shake256(%s): ", input);
+        print((const uint8_t *)digest, 64);
+        printf("\n");
+    }
+
     return 0;
 }
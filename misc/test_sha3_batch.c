@@ -0,0 +1,93 @@
+#define USE_KECCAK 1
+#include "sha3.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+static void print(const uint8_t *data, int length) {
+    for (int i = 0; i < length; ++i) {
+        printf("%02x", data[i]);
+    }
+}
+
+#define BATCH_SIZE 100
+
+typedef void (*batch_fn)(const unsigned char **, const size_t *, size_t,
+                         unsigned char *);
+typedef void (*oneshot_fn)(const unsigned char *, size_t, unsigned char *);
+
+static uint8_t data[BATCH_SIZE][4 * MYC_SHA3_224_BLOCK_LENGTH];
+static const uint8_t *messages[BATCH_SIZE];
+static size_t lens[BATCH_SIZE];
+
+/**
+Each message of the batch is hashed with the one-shot function too
+and both digests must match. Batches of count messages are hashed
+so that both small batches and the large ones given to the widest
+multi-buffer permutations are covered.
+*/
+
+static int test(const char *name, batch_fn batch, oneshot_fn oneshot,
+                int digest_size, size_t count) {
+    uint8_t digests[BATCH_SIZE * MYC_SHA3_512_DIGEST_LENGTH];
+    uint8_t digest[MYC_SHA3_512_DIGEST_LENGTH];
+    int failed = 0;
+
+    batch(messages, lens, count, digests);
+
+    for (size_t n = 0; n < count; ++n) {
+        const uint8_t *batch_digest = digests + n * digest_size;
+
+        oneshot(messages[n], lens[n], digest);
+
+        printf("%s_batch(%zu/%zu, %zu bytes): ", name, n, count, lens[n]);
+        print(batch_digest, digest_size);
+        if (memcmp(batch_digest, digest, digest_size) != 0) {
+            printf(" MISMATCH");
+            failed = 1;
+        }
+        printf("\n");
+    }
+
+    return failed;
+}
+
+/**
+Message n is n * 5 bytes of (n + i) & 0xff, so lengths cover every
+rate boundary and messages finish after different numbers of blocks.
+*/
+
+int main() {
+    int failed = 0;
+
+    for (int n = 0; n < BATCH_SIZE; ++n) {
+        lens[n] = (size_t) n * 5;
+        for (size_t i = 0; i < lens[n]; ++i) {
+            data[n][i] = (uint8_t) (n + i);
+        }
+        messages[n] = data[n];
+    }
+
+    printf("Testing SHA3/Keccak batch against one-shot hashing:\n");
+
+    failed |= test("sha3_224", myc_sha3_224_batch, myc_sha3_224,
+                   MYC_SHA3_224_DIGEST_LENGTH, 37);
+    failed |= test("sha3_256", myc_sha3_256_batch, myc_sha3_256,
+                   MYC_SHA3_256_DIGEST_LENGTH, 37);
+    failed |= test("sha3_384", myc_sha3_384_batch, myc_sha3_384,
+                   MYC_SHA3_384_DIGEST_LENGTH, 37);
+    failed |= test("sha3_512", myc_sha3_512_batch, myc_sha3_512,
+                   MYC_SHA3_512_DIGEST_LENGTH, 37);
+    failed |= test("keccak_256", myc_keccak_256_batch, myc_keccak_256,
+                   MYC_SHA3_256_DIGEST_LENGTH, 37);
+    failed |= test("keccak_512", myc_keccak_512_batch, myc_keccak_512,
+                   MYC_SHA3_512_DIGEST_LENGTH, 37);
+
+    failed |= test("sha3_256", myc_sha3_256_batch, myc_sha3_256,
+                   MYC_SHA3_256_DIGEST_LENGTH, BATCH_SIZE);
+    failed |= test("keccak_256", myc_keccak_256_batch, myc_keccak_256,
+                   MYC_SHA3_256_DIGEST_LENGTH, BATCH_SIZE);
+
+    return failed;
+}
@@ -0,0 +1,217 @@
+#include "ripemd160.h"
+#include "sha2.h"
+#include "sha3.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+#define MESSAGE_LENGTH 400
+
+static uint8_t message[MESSAGE_LENGTH];
+
+/**
+The message is hashed up to split bytes, the state is exported and
+imported into a context filled with garbage, and the rest of the
+message is hashed from there. The digest must be the one of the whole
+message, for splits at every offset within a block.
+*/
+
+static int report(const char *name, size_t split, const uint8_t *digest,
+                  const uint8_t *expected, int length) {
+    if (memcmp(digest, expected, length) != 0) {
+        printf("%s state after %zu bytes: MISMATCH\n", name, split);
+        return 1;
+    }
+    return 0;
+}
+
+#define TEST_SHA2(name, ctx_type, size)                                 \
+static int test_##name(void) {                                          \
+    uint8_t state[MYC_##size##_STATE_SIZE];                             \
+    uint8_t expected[64], digest[64];                                   \
+    ctx_type ctx;                                                       \
+    int failed = 0;                                                     \
+                                                                        \
+    myc_##name(message, MESSAGE_LENGTH, expected);                      \
+    for (size_t split = 0; split <= MESSAGE_LENGTH; split += 3) {       \
+        myc_##name##_init(&ctx);                                        \
+        myc_##name##_update(&ctx, message, split);                      \
+        myc_##name##_export_state(&ctx, state);                         \
+        memset(&ctx, 0xa5, sizeof(ctx));                                \
+        if (myc_##name##_import_state(&ctx, state) != 0) {              \
+            printf(#name " import after %zu bytes: FAILED\n", split);   \
+            failed = 1;                                                 \
+            continue;                                                   \
+        }                                                               \
+        myc_##name##_update(&ctx, message + split,                      \
+                            MESSAGE_LENGTH - split);                    \
+        myc_##name##_final(&ctx, digest);                               \
+        failed |= report(#name, split, digest, expected,                \
+                         MYC_##size##_DIGEST_SIZE);                     \
+    }                                                                   \
+    printf(#name ": %s\n", failed ? "FAILED" : "ok");                   \
+    return failed;                                                      \
+}
+
+TEST_SHA2(sha224, myc_sha224_ctx, SHA224)
+TEST_SHA2(sha256, myc_sha256_ctx, SHA256)
+TEST_SHA2(sha384, myc_sha384_ctx, SHA384)
+TEST_SHA2(sha512, myc_sha512_ctx, SHA512)
+
+static int test_ripemd160(void) {
+    uint8_t state[MYC_RIPEMD160_STATE_SIZE];
+    uint8_t expected[MYC_RIPEMD160_DIGEST_LENGTH];
+    uint8_t digest[MYC_RIPEMD160_DIGEST_LENGTH];
+    MYC_RIPEMD160_CTX ctx;
+    int failed = 0;
+
+    myc_ripemd160(message, MESSAGE_LENGTH, expected);
+    for (size_t split = 0; split <= MESSAGE_LENGTH; split += 3) {
+        myc_ripemd160_Init(&ctx);
+        myc_ripemd160_Update(&ctx, message, (uint32_t) split);
+        myc_ripemd160_export_state(&ctx, state);
+        memset(&ctx, 0xa5, sizeof(ctx));
+        if (myc_ripemd160_import_state(&ctx, state) != 0) {
+            printf("ripemd160 import after %zu bytes: FAILED\n", split);
+            failed = 1;
+            continue;
+        }
+        myc_ripemd160_Update(&ctx, message + split,
+                             (uint32_t) (MESSAGE_LENGTH - split));
+        myc_ripemd160_Final(&ctx, digest);
+        failed |= report("ripemd160", split, digest, expected,
+                         MYC_RIPEMD160_DIGEST_LENGTH);
+    }
+    printf("ripemd160: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
+
+static int test_sha3(const char *name, void (*init)(MYC_SHA3_CTX *),
+                     void (*oneshot)(const unsigned char *, size_t,
+                                     unsigned char *),
+                     int digest_size) {
+    uint8_t state[MYC_SHA3_STATE_SIZE];
+    uint8_t expected[64], digest[64];
+    MYC_SHA3_CTX ctx;
+    int failed = 0;
+
+    oneshot(message, MESSAGE_LENGTH, expected);
+    for (size_t split = 0; split <= MESSAGE_LENGTH; split += 3) {
+        init(&ctx);
+        myc_sha3_Update(&ctx, message, split);
+        if (myc_sha3_export_state(&ctx, state) != 0) {
+            printf("%s export after %zu bytes: FAILED\n", name, split);
+            failed = 1;
+            continue;
+        }
+        memset(&ctx, 0xa5, sizeof(ctx));
+        if (myc_sha3_import_state(&ctx, state) != 0) {
+            printf("%s import after %zu bytes: FAILED\n", name, split);
+            failed = 1;
+            continue;
+        }
+        myc_sha3_Update(&ctx, message + split, MESSAGE_LENGTH - split);
+        myc_sha3_Final(&ctx, digest);
+        failed |= report(name, split, digest, expected, digest_size);
+    }
+    printf("%s: %s\n", name, failed ? "FAILED" : "ok");
+    return failed;
+}
+
+/**
+The exported bytes do not depend on the host: after "abc", a SHA-256
+state is the version, the algorithm, the length 3 on 8 bytes, the
+initial chaining value and "abc" padded with zeros. States of another
+algorithm or version are rejected, and so are finalized SHA3 contexts.
+*/
+
+static int test_format(void) {
+    static const uint8_t head[] = {
+        1, 2, 0, 0, 0, 0, 0, 0, 0, 3, 0x6a, 0x09, 0xe6, 0x67
+    };
+    uint8_t state[MYC_SHA512_STATE_SIZE];
+    uint8_t sha3_state[MYC_SHA3_STATE_SIZE];
+    myc_sha256_ctx ctx256;
+    myc_sha512_ctx ctx512;
+    MYC_SHA3_CTX ctx3;
+    int failed = 0;
+
+    myc_sha256_init(&ctx256);
+    myc_sha256_update(&ctx256, (const uint8_t *) "abc", 3);
+    myc_sha256_export_state(&ctx256, state);
+    if (memcmp(state, head, sizeof(head)) != 0
+        || memcmp(state + 42, "abc", 3) != 0 || state[45] != 0)
+        failed = 1;
+    if (myc_sha224_import_state(&ctx256, state) != -1)
+        failed = 1;
+    if (myc_sha512_import_state(&ctx512, state) != -1)
+        failed = 1;
+
+    state[0] = 2;
+    if (myc_sha256_import_state(&ctx256, state) != -1)
+        failed = 1;
+
+    /* the high word of a 128-bit length survives the round trip */
+    myc_sha512_init(&ctx512);
+    ctx512.tot_len[0] = 0xffffffffffffff80ULL;
+    ctx512.tot_len[1] = 5;
+    myc_sha512_update(&ctx512, (const uint8_t *) "abc", 3);
+    myc_sha512_export_state(&ctx512, state);
+    memset(&ctx512, 0, sizeof(ctx512));
+    if (myc_sha512_import_state(&ctx512, state) != 0
+        || ctx512.tot_len[1] != 5
+        || ctx512.tot_len[0] != 0xffffffffffffff80ULL || ctx512.len != 3)
+        failed = 1;
+
+    myc_sha3_256_Init(&ctx3);
+    myc_sha3_export_state(&ctx3, sha3_state);
+    sha3_state[3] = MYC_SHA3_256_BLOCK_LENGTH;
+    if (myc_sha3_import_state(&ctx3, sha3_state) != -1)
+        failed = 1;
+    sha3_state[3] = 0;
+    sha3_state[2] = 100;
+    if (myc_sha3_import_state(&ctx3, sha3_state) != -1)
+        failed = 1;
+
+    /* finalized contexts, flagged or wiped by Final, are not exported */
+    myc_sha3_256_Init(&ctx3);
+    myc_sha3_Update(&ctx3, (const uint8_t *) "abc", 3);
+    ctx3.rest |= 0x80000000;
+    if (myc_sha3_export_state(&ctx3, sha3_state) != -1)
+        failed = 1;
+    myc_sha3_256_Init(&ctx3);
+    myc_sha3_Final(&ctx3, sha3_state);
+    if (myc_sha3_export_state(&ctx3, sha3_state) != -1)
+        failed = 1;
+
+    printf("format: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
+
+int main() {
+    int failed = 0;
+
+    for (size_t i = 0; i < MESSAGE_LENGTH; ++i) {
+        message[i] = (uint8_t) (i * 11 + 3);
+    }
+
+    printf("Testing state export and import:\n");
+
+    failed |= test_sha224();
+    failed |= test_sha256();
+    failed |= test_sha384();
+    failed |= test_sha512();
+    failed |= test_ripemd160();
+    failed |= test_sha3("sha3_224", myc_sha3_224_Init, myc_sha3_224,
+                        MYC_SHA3_224_DIGEST_LENGTH);
+    failed |= test_sha3("sha3_256", myc_sha3_256_Init, myc_sha3_256,
+                        MYC_SHA3_256_DIGEST_LENGTH);
+    failed |= test_sha3("sha3_384", myc_sha3_384_Init, myc_sha3_384,
+                        MYC_SHA3_384_DIGEST_LENGTH);
+    failed |= test_sha3("sha3_512", myc_sha3_512_Init, myc_sha3_512,
+                        MYC_SHA3_512_DIGEST_LENGTH);
+    failed |= test_format();
+
+    return failed;
+}
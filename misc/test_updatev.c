@@ -0,0 +1,122 @@
+#include "hmac_sha2.h"
+#include "hmac_sha3.h"
+#include "ripemd160.h"
+#include "sha2.h"
+#include "sha3.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/uio.h>
+
+static void print(const uint8_t *data, int length) {
+    for (int i = 0; i < length; ++i) {
+        printf("%02x", data[i]);
+    }
+}
+
+#define MESSAGE_LENGTH 1000
+
+static uint8_t message[MESSAGE_LENGTH];
+static const uint8_t key[] = "key for the HMAC tests";
+
+/**
+The message is split into a header, a body and a trailer, the header
+and trailer lengths being chosen so that fragments start and end at
+every offset within a block. Hashing the fragments with *_updatev()
+must give the digest of the whole message.
+*/
+
+static int split(size_t n, struct iovec *iov) {
+    size_t head = n % 150;
+    size_t tail = (n * 7) % 150;
+
+    iov[0].iov_base = message;
+    iov[0].iov_len = head;
+    iov[1].iov_base = message + head;
+    iov[1].iov_len = MESSAGE_LENGTH - head - tail;
+    iov[2].iov_base = message + MESSAGE_LENGTH - tail;
+    iov[2].iov_len = tail;
+
+    return 3;
+}
+
+static int report(const char *name, size_t n, const uint8_t *digest,
+                  const uint8_t *expected, int length) {
+    printf("%s_updatev(%zu): ", name, n);
+    print(digest, length);
+    if (memcmp(digest, expected, length) != 0) {
+        printf(" MISMATCH");
+        printf("\n");
+        return 1;
+    }
+    printf("\n");
+    return 0;
+}
+
+int main() {
+    uint8_t expected[64], digest[64];
+    struct iovec iov[3];
+    int failed = 0;
+
+    for (size_t i = 0; i < MESSAGE_LENGTH; ++i) {
+        message[i] = (uint8_t) (i * 11 + 3);
+    }
+
+    printf("Testing scatter/gather updates against one-shot hashing:\n");
+
+    for (size_t n = 0; n < 150; n += 7) {
+        int cnt = split(n, iov);
+        myc_sha256_ctx sha256;
+        myc_sha512_ctx sha512;
+        MYC_SHA3_CTX sha3;
+        MYC_RIPEMD160_CTX ripemd160;
+        myc_hmac_sha256_ctx hmac_sha256;
+        myc_hmac_sha3_256_ctx hmac_sha3_256;
+
+        myc_sha256(message, MESSAGE_LENGTH, expected);
+        myc_sha256_init(&sha256);
+        myc_sha256_updatev(&sha256, iov, cnt);
+        myc_sha256_final(&sha256, digest);
+        failed |= report("sha256", n, digest, expected, MYC_SHA256_DIGEST_SIZE);
+
+        myc_sha512(message, MESSAGE_LENGTH, expected);
+        myc_sha512_init(&sha512);
+        myc_sha512_updatev(&sha512, iov, cnt);
+        myc_sha512_final(&sha512, digest);
+        failed |= report("sha512", n, digest, expected, MYC_SHA512_DIGEST_SIZE);
+
+        myc_sha3_256(message, MESSAGE_LENGTH, expected);
+        myc_sha3_256_Init(&sha3);
+        myc_sha3_Updatev(&sha3, iov, cnt);
+        myc_sha3_Final(&sha3, digest);
+        failed |= report("sha3_256", n, digest, expected,
+                         MYC_SHA3_256_DIGEST_LENGTH);
+
+        myc_ripemd160(message, MESSAGE_LENGTH, expected);
+        myc_ripemd160_Init(&ripemd160);
+        myc_ripemd160_Updatev(&ripemd160, iov, cnt);
+        myc_ripemd160_Final(&ripemd160, digest);
+        failed |= report("ripemd160", n, digest, expected,
+                         MYC_RIPEMD160_DIGEST_LENGTH);
+
+        myc_hmac_sha256(key, sizeof(key), message, MESSAGE_LENGTH, expected,
+                        MYC_SHA256_DIGEST_SIZE);
+        myc_hmac_sha256_init(&hmac_sha256, key, sizeof(key));
+        myc_hmac_sha256_updatev(&hmac_sha256, iov, cnt);
+        myc_hmac_sha256_final(&hmac_sha256, digest, MYC_SHA256_DIGEST_SIZE);
+        failed |= report("hmac_sha256", n, digest, expected,
+                         MYC_SHA256_DIGEST_SIZE);
+
+        myc_hmac_sha3_256(key, sizeof(key), message, MESSAGE_LENGTH, expected,
+                          MYC_SHA3_256_DIGEST_LENGTH);
+        myc_hmac_sha3_256_init(&hmac_sha3_256, key, sizeof(key));
+        myc_hmac_sha3_256_updatev(&hmac_sha3_256, iov, cnt);
+        myc_hmac_sha3_256_final(&hmac_sha3_256, digest,
+                                MYC_SHA3_256_DIGEST_LENGTH);
+        failed |= report("hmac_sha3_256", n, digest, expected,
+                         MYC_SHA3_256_DIGEST_LENGTH);
+    }
+
+    return failed;
+}
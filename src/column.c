@@ -0,0 +1,163 @@
+/*
+ * Hashing of columns of values
+ *
+ * A column is one data buffer holding count values, either all of the
+ * same width or delimited by count + 1 64-bit offsets as in Arrow
+ * large binary columns. Values are given to the batch hashing in chunks
+ * of pointers and lengths built on the stack, so that no value is
+ * copied. Large columns may be split into ranges of rows hashed by
+ * several threads.
+ */
+
+#include "dispatch.h"
+
+#if MYC_HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+/* Values per call to the batch hashing */
+#define COLUMN_CHUNK 256
+
+/* Rows below which adding a thread costs more than it saves */
+#define COLUMN_MIN_ROWS_PER_THREAD 4096
+
+#define COLUMN_MAX_THREADS 64
+
+typedef void (*column_batch_fn)(const unsigned char **messages,
+                                const size_t *lens, size_t count,
+                                unsigned char *digests);
+
+typedef struct {
+    column_batch_fn batch;
+    size_t digest_size;
+    const unsigned char *data;
+    const int64_t *offsets;     /* NULL for values of width bytes */
+    size_t width;
+    size_t first;               /* rows first .. first + count - 1 */
+    size_t count;
+    unsigned char *digests;
+} column_range;
+
+static void column_hash(const column_range *r)
+{
+    const unsigned char *messages[COLUMN_CHUNK];
+    size_t lens[COLUMN_CHUNK];
+    size_t end = r->first + r->count;
+    size_t row, n, i;
+
+    for (row = r->first; row < end; row += n) {
+        n = end - row < COLUMN_CHUNK ? end - row : COLUMN_CHUNK;
+        if (r->offsets != NULL) {
+            for (i = 0; i < n; i++) {
+                messages[i] = r->data + (size_t) r->offsets[row + i];
+                lens[i] = (size_t) (r->offsets[row + i + 1]
+                                    - r->offsets[row + i]);
+            }
+        }
+        else {
+            for (i = 0; i < n; i++) {
+                messages[i] = r->data + (row + i) * r->width;
+                lens[i] = r->width;
+            }
+        }
+        r->batch(messages, lens, n, r->digests + row * r->digest_size);
+    }
+}
+
+#if MYC_HAVE_PTHREAD
+static void *column_thread(void *arg)
+{
+    column_hash((const column_range *) arg);
+    return NULL;
+}
+#endif
+
+static void column(column_batch_fn batch, size_t digest_size,
+                   const unsigned char *data, const int64_t *offsets,
+                   size_t width, size_t count, unsigned char *digests,
+                   unsigned int threads)
+{
+    column_range ranges[COLUMN_MAX_THREADS];
+#if MYC_HAVE_PTHREAD
+    pthread_t ids[COLUMN_MAX_THREADS];
+    int started[COLUMN_MAX_THREADS];
+#endif
+    size_t first = 0;
+    unsigned int t;
+
+#if !MYC_HAVE_PTHREAD
+    threads = 1;
+#endif
+    if (threads > COLUMN_MAX_THREADS)
+        threads = COLUMN_MAX_THREADS;
+    if (threads > count / COLUMN_MIN_ROWS_PER_THREAD)
+        threads = (unsigned int) (count / COLUMN_MIN_ROWS_PER_THREAD);
+    if (threads == 0)
+        threads = 1;
+
+    /* Bind the backends before any other thread hashes */
+    myc_dispatch_init();
+
+    for (t = 0; t < threads; t++) {
+        ranges[t].batch = batch;
+        ranges[t].digest_size = digest_size;
+        ranges[t].data = data;
+        ranges[t].offsets = offsets;
+        ranges[t].width = width;
+        ranges[t].first = first;
+        ranges[t].count = count / threads + (t < count % threads);
+        ranges[t].digests = digests;
+        first += ranges[t].count;
+    }
+
+#if MYC_HAVE_PTHREAD
+    /* A range whose thread could not be started is hashed here */
+    for (t = 1; t < threads; t++) {
+        started[t] = pthread_create(&ids[t], NULL, column_thread,
+                                    &ranges[t]) == 0;
+    }
+    column_hash(&ranges[0]);
+    for (t = 1; t < threads; t++) {
+        if (started[t])
+            pthread_join(ids[t], NULL);
+        else
+            column_hash(&ranges[t]);
+    }
+#else
+    column_hash(&ranges[0]);
+#endif
+}
+
+#define COLUMN_FUNCTIONS(name, batch, digest_size)                      \
+void myc_##name##_column(const unsigned char *data,                     \
+                         const int64_t *offsets, size_t count,          \
+                         unsigned char *digests, unsigned int threads)  \
+{                                                                       \
+    column((column_batch_fn) batch, digest_size, data, offsets, 0,      \
+           count, digests, threads);                                    \
+}                                                                       \
+                                                                        \
+void myc_##name##_column_fixed(const unsigned char *data, size_t width, \
+                               size_t count, unsigned char *digests,    \
+                               unsigned int threads)                    \
+{                                                                       \
+    column((column_batch_fn) batch, digest_size, data, NULL, width,     \
+           count, digests, threads);                                    \
+}
+
+COLUMN_FUNCTIONS(sha224, myc_sha224_batch, MYC_SHA224_DIGEST_SIZE)
+COLUMN_FUNCTIONS(sha256, myc_sha256_batch, MYC_SHA256_DIGEST_SIZE)
+COLUMN_FUNCTIONS(sha384, myc_sha384_batch, MYC_SHA384_DIGEST_SIZE)
+COLUMN_FUNCTIONS(sha512, myc_sha512_batch, MYC_SHA512_DIGEST_SIZE)
+
+COLUMN_FUNCTIONS(sha3_224, myc_sha3_224_batch, MYC_SHA3_224_DIGEST_LENGTH)
+COLUMN_FUNCTIONS(sha3_256, myc_sha3_256_batch, MYC_SHA3_256_DIGEST_LENGTH)
+COLUMN_FUNCTIONS(sha3_384, myc_sha3_384_batch, MYC_SHA3_384_DIGEST_LENGTH)
+COLUMN_FUNCTIONS(sha3_512, myc_sha3_512_batch, MYC_SHA3_512_DIGEST_LENGTH)
+
+#if USE_KECCAK
+COLUMN_FUNCTIONS(keccak_256, myc_keccak_256_batch, MYC_SHA3_256_DIGEST_LENGTH)
+COLUMN_FUNCTIONS(keccak_512, myc_keccak_512_batch, MYC_SHA3_512_DIGEST_LENGTH)
+#endif
+
+COLUMN_FUNCTIONS(ripemd160, myc_ripemd160_batch, MYC_RIPEMD160_DIGEST_LENGTH)
@@ -0,0 +1,838 @@
+/*
+ * Runtime CPU feature detection and compression function dispatch
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dispatch.h"
+
+#if MYC_HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+#ifdef MYC_X86
+#include <cpuid.h>
+#endif
+
+/* Implementations of each function, best first */
+
+static const struct {
+    myc_backend backend;
+    unsigned int features;
+    sha256_transf_fn fn;
+} sha256_impls[] = {
+#ifdef MYC_X86
+    { MYC_BACKEND_SHANI,  MYC_CPU_SHA | MYC_CPU_SSE41, sha256_transf_shani },
+    { MYC_BACKEND_AVX2,   MYC_CPU_AVX2 | MYC_CPU_BMI1 | MYC_CPU_BMI2,
+      sha256_transf_avx2 },
+    /* VEX encoded build of the SSSE3 transform */
+    { MYC_BACKEND_SSSE3,  MYC_CPU_AVX | MYC_CPU_SSSE3, sha256_transf_avx },
+    { MYC_BACKEND_SSSE3,  MYC_CPU_SSSE3, sha256_transf_ssse3 },
+#endif
+    { MYC_BACKEND_SCALAR, 0, sha256_transf_c }
+};
+
+#define SMALL (1u << MYC_BATCH_SMALL)
+#define LARGE (1u << MYC_BATCH_LARGE)
+
+static const struct {
+    myc_backend backend;
+    unsigned int features;
+    unsigned int classes;
+    sha256_mb_impl impl;
+} sha256_mb_impls[] = {
+#ifdef MYC_X86
+    { MYC_BACKEND_AVX512, MYC_CPU_AVX512F, LARGE,
+      { sha256_transf_x16_avx512, 16 } },
+    /* SHA-NI hashes one stream faster than 8 AVX2 lanes */
+    { MYC_BACKEND_SHANI,  MYC_CPU_SHA | MYC_CPU_SSE41, SMALL | LARGE,
+      { NULL, 1 } },
+    { MYC_BACKEND_AVX2,   MYC_CPU_AVX2, SMALL | LARGE,
+      { sha256_transf_x8_avx2, 8 } },
+    /* Two scalar lanes do not fit in 16 registers and spill */
+    { MYC_BACKEND_SCALAR, 0, SMALL | LARGE, { NULL, 1 } },
+#endif
+    { MYC_BACKEND_SCALAR, 0, SMALL | LARGE, { sha256_transf_x2_c, 2 } }
+};
+
+static const struct {
+    myc_backend backend;
+    unsigned int features;
+    sha512_transf_fn fn;
+} sha512_impls[] = {
+#ifdef MYC_X86
+    { MYC_BACKEND_AVX2,   MYC_CPU_AVX2 | MYC_CPU_BMI1 | MYC_CPU_BMI2,
+      sha512_transf_avx2 },
+#endif
+    { MYC_BACKEND_SCALAR, 0, sha512_transf_c }
+};
+
+static const struct {
+    myc_backend backend;
+    unsigned int features;
+    unsigned int classes;
+    sha512_mb_impl impl;
+} sha512_mb_impls[] = {
+#ifdef MYC_X86
+    { MYC_BACKEND_AVX512, MYC_CPU_AVX512F, SMALL | LARGE,
+      { sha512_transf_x8_avx512, 8 } },
+    { MYC_BACKEND_AVX2,   MYC_CPU_AVX2, SMALL | LARGE,
+      { sha512_transf_x4_avx2, 4 } },
+#endif
+    { MYC_BACKEND_SCALAR, 0, SMALL | LARGE, { NULL, 1 } }
+};
+
+static const struct {
+    myc_backend backend;
+    unsigned int features;
+    sha3_permutation_fn fn;
+} sha3_impls[] = {
+#ifdef MYC_X86
+    { MYC_BACKEND_SCALAR, MYC_CPU_BMI1, myc_sha3_permutation_bmi1 },
+    /* Slower than BMI1 for one state, only bound when asked or tuned */
+    { MYC_BACKEND_AVX512, MYC_CPU_AVX512F, myc_sha3_permutation_avx512 },
+#endif
+    { MYC_BACKEND_SCALAR, 0, myc_sha3_permutation_c }
+};
+
+static const struct {
+    myc_backend backend;
+    unsigned int features;
+    unsigned int classes;
+    sha3_mb_impl impl;
+} sha3_mb_impls[] = {
+#ifdef MYC_X86
+    { MYC_BACKEND_AVX512, MYC_CPU_AVX512F, SMALL | LARGE,
+      { myc_sha3_permutation_x8_avx512, 8 } },
+    { MYC_BACKEND_AVX2,   MYC_CPU_AVX2, SMALL | LARGE,
+      { myc_sha3_permutation_x4_avx2, 4 } },
+#endif
+    { MYC_BACKEND_SCALAR, 0, SMALL | LARGE, { NULL, 1 } }
+};
+
+static const struct {
+    myc_backend backend;
+    unsigned int features;
+    ripemd160_process_fn fn;
+} ripemd160_impls[] = {
+    { MYC_BACKEND_SCALAR, 0, myc_ripemd160_process_c }
+};
+
+static const struct {
+    myc_backend backend;
+    unsigned int features;
+    unsigned int classes;
+    ripemd160_mb_impl impl;
+} ripemd160_mb_impls[] = {
+#ifdef MYC_X86
+    { MYC_BACKEND_AVX512, MYC_CPU_AVX512F, LARGE,
+      { myc_ripemd160_process_x16_avx512, 16 } },
+    { MYC_BACKEND_AVX2,   MYC_CPU_AVX2, SMALL | LARGE,
+      { myc_ripemd160_process_x8_avx2, 8 } },
+    /* SSE2 only, which every SSSE3 CPU has */
+    { MYC_BACKEND_SSSE3,  MYC_CPU_SSSE3, SMALL | LARGE,
+      { myc_ripemd160_process_x4_sse2, 4 } },
+    { MYC_BACKEND_SCALAR, 0, SMALL | LARGE, { NULL, 1 } },
+#endif
+    { MYC_BACKEND_SCALAR, 0, SMALL | LARGE,
+      { myc_ripemd160_process_x2_c, 2 } }
+};
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+#define DISPATCH_SUPPORTED(impl, features)                              \
+    (((impl).features & features) == (impl).features)
+
+#define DISPATCH_ALLOWED(impl, cap, features)                           \
+    ((cap == MYC_BACKEND_AUTO || (impl).backend <= cap)                 \
+     && DISPATCH_SUPPORTED(impl, features))
+
+/*
+ * Index of the first implementation of the backend named by the cap,
+ * else of the first one allowed by the cap and the CPU. A backend may
+ * come after a faster one of a lower backend.
+ */
+#define DISPATCH_SELECT(impls, cap, features, k)                        \
+{                                                                       \
+    for (k = 0; k + 1 < ARRAY_SIZE(impls); k++) {                       \
+        if (impls[k].backend == cap                                     \
+            && DISPATCH_SUPPORTED(impls[k], features))                  \
+            break;                                                      \
+    }                                                                   \
+    if (impls[k].backend != cap) {                                      \
+        for (k = 0; k + 1 < ARRAY_SIZE(impls); k++) {                   \
+            if (DISPATCH_ALLOWED(impls[k], cap, features))              \
+                break;                                                  \
+        }                                                               \
+    }                                                                   \
+}
+
+/* Same for the multi-buffer engines serving batch size class c */
+#define DISPATCH_SELECT_MB(impls, cap, features, c, k)                  \
+{                                                                       \
+    for (k = 0; k + 1 < ARRAY_SIZE(impls); k++) {                       \
+        if ((impls[k].classes & (1u << (c)))                            \
+            && DISPATCH_ALLOWED(impls[k], cap, features))               \
+            break;                                                      \
+    }                                                                   \
+}
+
+/*
+ * Autotuned choices, index + 1 in the arrays or 0 when untuned, for
+ * one stream (shape 0) and for each batch size class (shape 1 + c)
+ */
+#define TUNE_SHAPES (1 + MYC_BATCH_CLASSES)
+
+static unsigned int dispatch_tuned[MYC_HASH_COUNT][TUNE_SHAPES];
+
+/* The autotuned implementation if the cap allows it, else as above */
+#define DISPATCH_PICK(impls, cap, features, tuned, k)                   \
+{                                                                       \
+    if ((tuned) > 0                                                     \
+        && DISPATCH_ALLOWED(impls[(tuned) - 1], cap, features))         \
+        k = (tuned) - 1;                                                \
+    else                                                                \
+        DISPATCH_SELECT(impls, cap, features, k);                       \
+}
+
+#define DISPATCH_PICK_MB(impls, cap, features, c, tuned, k)             \
+{                                                                       \
+    if ((tuned) > 0                                                     \
+        && DISPATCH_ALLOWED(impls[(tuned) - 1], cap, features))         \
+        k = (tuned) - 1;                                                \
+    else                                                                \
+        DISPATCH_SELECT_MB(impls, cap, features, c, k);                 \
+}
+
+static void sha256_transf_resolve(uint32 *h, const unsigned char *message,
+                                  size_t block_nb);
+static void sha512_transf_resolve(uint64 *h, const unsigned char *message,
+                                  size_t block_nb);
+static void sha3_permutation_resolve(uint64_t *state);
+static void ripemd160_process_resolve(uint32_t *state, const uint8_t *data,
+                                      size_t block_nb);
+
+myc_dispatch_table myc_dispatch = {
+    sha256_transf_resolve,
+    sha512_transf_resolve,
+    sha3_permutation_resolve,
+    ripemd160_process_resolve,
+    { { NULL, 1 }, { NULL, 1 } },
+    { { NULL, 1 }, { NULL, 1 } },
+    { { NULL, 1 }, { NULL, 1 } },
+    { { NULL, 1 }, { NULL, 1 } }
+};
+
+/*
+ * The first hash of any thread may bind the table, and with
+ * MYC_HASHING_AUTOTUNE tune it first, so the lazy init runs once for
+ * the process. Tuning and binding, implicit or explicit, hold
+ * dispatch_lock so that the tuned choices and the cache file are only
+ * written by one thread at a time.
+ */
+#if MYC_HAVE_PTHREAD
+static pthread_once_t dispatch_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t dispatch_lock = PTHREAD_MUTEX_INITIALIZER;
+#define DISPATCH_LOCK()   pthread_mutex_lock(&dispatch_lock)
+#define DISPATCH_UNLOCK() pthread_mutex_unlock(&dispatch_lock)
+#else
+static int dispatch_ready;
+#define DISPATCH_LOCK()
+#define DISPATCH_UNLOCK()
+#endif
+static myc_backend dispatch_cap[MYC_HASH_COUNT];
+static myc_backend dispatch_bound[MYC_HASH_COUNT];
+
+static const char *const backend_names[] = {
+    "auto", "scalar", "ssse3", "avx2", "avx512", "shani"
+};
+
+#ifdef MYC_X86
+static unsigned long long xgetbv0(void)
+{
+    unsigned int eax, edx;
+
+    __asm__ __volatile__("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+    return ((unsigned long long) edx << 32) | eax;
+}
+
+static unsigned int cpu_detect(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+    unsigned int max_leaf, features = 0;
+    unsigned long long xcr0 = 0;
+    int os_ymm = 0, os_zmm = 0;
+
+    max_leaf = __get_cpuid_max(0, NULL);
+    if (max_leaf < 1)
+        return 0;
+
+    __cpuid(1, eax, ebx, ecx, edx);
+    if (ecx & (1u << 9))
+        features |= MYC_CPU_SSSE3;
+    if (ecx & (1u << 19))
+        features |= MYC_CPU_SSE41;
+    /* OSXSAVE: the OS saves the extended register state */
+    if (ecx & (1u << 27)) {
+        xcr0 = xgetbv0();
+        os_ymm = (xcr0 & 0x06) == 0x06;
+        os_zmm = os_ymm && (xcr0 & 0xE0) == 0xE0;
+    }
+    if ((ecx & (1u << 28)) && os_ymm)
+        features |= MYC_CPU_AVX;
+
+    if (max_leaf < 7)
+        return features;
+
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    if (ebx & (1u << 3))
+        features |= MYC_CPU_BMI1;
+    if (ebx & (1u << 8))
+        features |= MYC_CPU_BMI2;
+    if (ebx & (1u << 29))
+        features |= MYC_CPU_SHA;
+    if ((ebx & (1u << 5)) && os_ymm)
+        features |= MYC_CPU_AVX2;
+    if ((ebx & (1u << 16)) && os_zmm) {
+        features |= MYC_CPU_AVX512F;
+        if (ebx & (1u << 31))
+            features |= MYC_CPU_AVX512VL;
+        if (ebx & (1u << 30))
+            features |= MYC_CPU_AVX512BW;
+    }
+
+    return features;
+}
+#else
+static unsigned int cpu_detect(void)
+{
+    return 0;
+}
+#endif /* MYC_X86 */
+
+unsigned int myc_cpu_features(void)
+{
+    static int detected;
+    static unsigned int features;
+
+    if (!detected) {
+        features = cpu_detect();
+        detected = 1;
+    }
+    return features;
+}
+
+static myc_backend backend_from_name(const char *name)
+{
+    size_t k;
+
+    for (k = 0; k < ARRAY_SIZE(backend_names); k++) {
+        if (strcmp(name, backend_names[k]) == 0)
+            return (myc_backend) k;
+    }
+    return MYC_BACKEND_AUTO;
+}
+
+#if defined(__GNUC__)
+#define DISPATCH_PUBLISH(field, fn)                                     \
+    __atomic_store_n(&myc_dispatch.field, fn, __ATOMIC_RELEASE)
+#else
+#define DISPATCH_PUBLISH(field, fn) (myc_dispatch.field = (fn))
+#endif
+
+/* Rebind every function according to the CPU, the caps and the tuning */
+static void dispatch_bind(void)
+{
+    unsigned int features = myc_cpu_features();
+    myc_dispatch_table table;
+    const unsigned int *tuned;
+    myc_backend cap;
+    size_t k;
+    int c;
+
+    cap = dispatch_cap[MYC_HASH_SHA256];
+    tuned = dispatch_tuned[MYC_HASH_SHA256];
+    DISPATCH_PICK(sha256_impls, cap, features, tuned[0], k);
+    table.sha256_transf = sha256_impls[k].fn;
+    dispatch_bound[MYC_HASH_SHA256] = sha256_impls[k].backend;
+    for (c = 0; c < MYC_BATCH_CLASSES; c++) {
+        DISPATCH_PICK_MB(sha256_mb_impls, cap, features, c, tuned[1 + c], k);
+        table.sha256_mb[c] = sha256_mb_impls[k].impl;
+    }
+
+    cap = dispatch_cap[MYC_HASH_SHA512];
+    tuned = dispatch_tuned[MYC_HASH_SHA512];
+    DISPATCH_PICK(sha512_impls, cap, features, tuned[0], k);
+    table.sha512_transf = sha512_impls[k].fn;
+    dispatch_bound[MYC_HASH_SHA512] = sha512_impls[k].backend;
+    for (c = 0; c < MYC_BATCH_CLASSES; c++) {
+        DISPATCH_PICK_MB(sha512_mb_impls, cap, features, c, tuned[1 + c], k);
+        table.sha512_mb[c] = sha512_mb_impls[k].impl;
+    }
+
+    cap = dispatch_cap[MYC_HASH_KECCAK];
+    tuned = dispatch_tuned[MYC_HASH_KECCAK];
+    DISPATCH_PICK(sha3_impls, cap, features, tuned[0], k);
+    table.sha3_permutation = sha3_impls[k].fn;
+    dispatch_bound[MYC_HASH_KECCAK] = sha3_impls[k].backend;
+    for (c = 0; c < MYC_BATCH_CLASSES; c++) {
+        DISPATCH_PICK_MB(sha3_mb_impls, cap, features, c, tuned[1 + c], k);
+        table.sha3_mb[c] = sha3_mb_impls[k].impl;
+    }
+
+    cap = dispatch_cap[MYC_HASH_RIPEMD160];
+    tuned = dispatch_tuned[MYC_HASH_RIPEMD160];
+    DISPATCH_PICK(ripemd160_impls, cap, features, tuned[0], k);
+    table.ripemd160_process = ripemd160_impls[k].fn;
+    dispatch_bound[MYC_HASH_RIPEMD160] = ripemd160_impls[k].backend;
+    for (c = 0; c < MYC_BATCH_CLASSES; c++) {
+        DISPATCH_PICK_MB(ripemd160_mb_impls, cap, features, c, tuned[1 + c],
+                         k);
+        table.ripemd160_mb[c] = ripemd160_mb_impls[k].impl;
+    }
+
+    /*
+     * The multi-buffer entries are only read after myc_dispatch_init().
+     * The single stream pointers are read by any caller at any time, so
+     * each is stored at once, and a caller sees either the resolver or
+     * an implementation.
+     */
+    memcpy(myc_dispatch.sha256_mb, table.sha256_mb, sizeof(table.sha256_mb));
+    memcpy(myc_dispatch.sha512_mb, table.sha512_mb, sizeof(table.sha512_mb));
+    memcpy(myc_dispatch.sha3_mb, table.sha3_mb, sizeof(table.sha3_mb));
+    memcpy(myc_dispatch.ripemd160_mb, table.ripemd160_mb,
+           sizeof(table.ripemd160_mb));
+    DISPATCH_PUBLISH(sha256_transf, table.sha256_transf);
+    DISPATCH_PUBLISH(sha512_transf, table.sha512_transf);
+    DISPATCH_PUBLISH(sha3_permutation, table.sha3_permutation);
+    DISPATCH_PUBLISH(ripemd160_process, table.ripemd160_process);
+}
+
+/* Autotuning */
+
+#define TUNE_VERSION 1
+
+#define TUNE_LANES  16
+#define TUNE_BLOCKS 4
+#define TUNE_RUNS   8
+
+/* Batch sizes standing for each size class */
+static const size_t tune_counts[MYC_BATCH_CLASSES] = {
+    8, MYC_BATCH_LARGE_MIN
+};
+
+static const char *const tune_alg_names[MYC_HASH_COUNT] = {
+    "sha256", "sha512", "keccak", "ripemd160"
+};
+
+static const char *const tune_shape_names[TUNE_SHAPES] = {
+    "single", "small", "large"
+};
+
+static unsigned char tune_data[TUNE_LANES][TUNE_BLOCKS
+                                            * MYC_SHA512_BLOCK_SIZE];
+
+static union {
+    uint32 sha256[8 * TUNE_LANES];
+    uint64 sha512[8 * TUNE_LANES];
+    uint64_t keccak[25 * TUNE_LANES];
+    uint32_t ripemd160[5 * TUNE_LANES];
+} tune_state;
+
+/* What the tuning and its cache need to know of an implementation */
+typedef struct {
+    myc_backend backend;
+    unsigned int features;
+    unsigned int lanes;         /* 0 for messages hashed one at a time */
+    unsigned int classes;
+} tune_impl;
+
+#define TUNE_DESCRIBE(impls, k, impl)                                   \
+{                                                                       \
+    if ((k) >= ARRAY_SIZE(impls))                                       \
+        return 0;                                                       \
+    (impl)->backend = impls[k].backend;                                 \
+    (impl)->features = impls[k].features;                               \
+    (impl)->lanes = 1;                                                  \
+    (impl)->classes = SMALL | LARGE;                                    \
+}
+
+#define TUNE_DESCRIBE_MB(impls, k, impl)                                \
+{                                                                       \
+    TUNE_DESCRIBE(impls, k, impl);                                      \
+    (impl)->lanes = impls[k].impl.fn != NULL ? impls[k].impl.lanes : 0; \
+    (impl)->classes = impls[k].classes;                                 \
+}
+
+/* Describe implementation k of a shape, returns 0 past the last one */
+static int tune_describe(int alg, int shape, size_t k, tune_impl *impl)
+{
+    switch (alg) {
+    case MYC_HASH_SHA256:
+        if (shape > 0)
+            TUNE_DESCRIBE_MB(sha256_mb_impls, k, impl)
+        else
+            TUNE_DESCRIBE(sha256_impls, k, impl)
+        break;
+    case MYC_HASH_SHA512:
+        if (shape > 0)
+            TUNE_DESCRIBE_MB(sha512_mb_impls, k, impl)
+        else
+            TUNE_DESCRIBE(sha512_impls, k, impl)
+        break;
+    case MYC_HASH_KECCAK:
+        if (shape > 0)
+            TUNE_DESCRIBE_MB(sha3_mb_impls, k, impl)
+        else
+            TUNE_DESCRIBE(sha3_impls, k, impl)
+        break;
+    default:
+        if (shape > 0)
+            TUNE_DESCRIBE_MB(ripemd160_mb_impls, k, impl)
+        else
+            TUNE_DESCRIBE(ripemd160_impls, k, impl)
+        break;
+    }
+    return 1;
+}
+
+/* Run implementation k on TUNE_BLOCKS blocks of each of its lanes */
+static void tune_run(int alg, int mb, size_t k)
+{
+    const unsigned char *data[TUNE_LANES];
+    int i;
+
+    for (i = 0; i < TUNE_LANES; i++) {
+        data[i] = tune_data[i];
+    }
+
+    switch (alg) {
+    case MYC_HASH_SHA256:
+        if (mb)
+            sha256_mb_impls[k].impl.fn(tune_state.sha256, data, TUNE_BLOCKS);
+        else
+            sha256_impls[k].fn(tune_state.sha256, data[0], TUNE_BLOCKS);
+        break;
+    case MYC_HASH_SHA512:
+        if (mb)
+            sha512_mb_impls[k].impl.fn(tune_state.sha512, data, TUNE_BLOCKS);
+        else
+            sha512_impls[k].fn(tune_state.sha512, data[0], TUNE_BLOCKS);
+        break;
+    case MYC_HASH_KECCAK:
+        for (i = 0; i < TUNE_BLOCKS; i++) {
+            if (mb)
+                sha3_mb_impls[k].impl.fn(tune_state.keccak);
+            else
+                sha3_impls[k].fn(tune_state.keccak);
+        }
+        break;
+    default:
+        if (mb)
+            ripemd160_mb_impls[k].impl.fn(tune_state.ripemd160, data,
+                                          TUNE_BLOCKS);
+        else
+            ripemd160_impls[k].fn(tune_state.ripemd160, data[0],
+                                  TUNE_BLOCKS);
+        break;
+    }
+}
+
+static double tune_clock(void)
+{
+#ifdef CLOCK_MONOTONIC
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+#else
+    return (double) clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+/* Best time of one run, after a first one warming up caches and units */
+static double tune_time(int alg, int mb, size_t k)
+{
+    double best = 0;
+    int i;
+
+    tune_run(alg, mb, k);
+    for (i = 0; i < TUNE_RUNS; i++) {
+        double t = tune_clock();
+
+        tune_run(alg, mb, k);
+        t = tune_clock() - t;
+        if (i == 0 || t < best)
+            best = t;
+    }
+    return best;
+}
+
+/*
+ * Time every implementation the CPU supports. The fastest one-stream
+ * implementation is kept, then for each size class the engine hashing
+ * a batch of tune_counts[c] messages the fastest, a multi-buffer run
+ * hashing as many messages as it has lanes and serial hashing one.
+ */
+static void tune_measure(unsigned int features)
+{
+    tune_impl impl;
+    double single = 0, best[MYC_BATCH_CLASSES] = { 0 };
+    size_t k;
+    int alg, c;
+
+    for (alg = 0; alg < MYC_HASH_COUNT; alg++) {
+        for (k = 0; tune_describe(alg, 0, k, &impl); k++) {
+            double t;
+
+            if (!DISPATCH_SUPPORTED(impl, features))
+                continue;
+            t = tune_time(alg, 0, k);
+            if (dispatch_tuned[alg][0] == 0 || t < single) {
+                single = t;
+                dispatch_tuned[alg][0] = (unsigned int) k + 1;
+            }
+        }
+
+        for (k = 0; tune_describe(alg, 1, k, &impl); k++) {
+            unsigned int lanes = impl.lanes > 0 ? impl.lanes : 1;
+            double run;
+
+            if (!DISPATCH_SUPPORTED(impl, features))
+                continue;
+            run = impl.lanes > 0 ? tune_time(alg, 1, k) : single;
+            for (c = 0; c < MYC_BATCH_CLASSES; c++) {
+                double t = run * (double) ((tune_counts[c] + lanes - 1)
+                                           / lanes);
+
+                if (!(impl.classes & (1u << c)))
+                    continue;
+                if (dispatch_tuned[alg][1 + c] == 0 || t < best[c]) {
+                    best[c] = t;
+                    dispatch_tuned[alg][1 + c] = (unsigned int) k + 1;
+                }
+            }
+        }
+    }
+}
+
+static int tune_name_index(const char *name, const char *const *names,
+                           int nb)
+{
+    int i;
+
+    for (i = 0; i < nb; i++) {
+        if (strcmp(name, names[i]) == 0)
+            return i;
+    }
+    return -1;
+}
+
+/*
+ * Read the choices saved by tune_save(), returns 0 when the cache was
+ * written on this CPU and names a usable implementation for every
+ * algorithm and shape.
+ */
+static int tune_load(const char *path, unsigned int features)
+{
+    char alg_name[16], shape_name[16], backend_name[16];
+    unsigned int version, cache_features, impl_features, lanes;
+    int loaded = 0;
+    FILE *f;
+
+    f = fopen(path, "r");
+    if (f == NULL)
+        return -1;
+
+    if (fscanf(f, "myc_hashing_tune %u %x", &version, &cache_features) != 2
+        || version != TUNE_VERSION || cache_features != features) {
+        fclose(f);
+        return -1;
+    }
+
+    while (fscanf(f, "%15s %15s %15s %x %u", alg_name, shape_name,
+                  backend_name, &impl_features, &lanes) == 5) {
+        int alg = tune_name_index(alg_name, tune_alg_names, MYC_HASH_COUNT);
+        int shape = tune_name_index(shape_name, tune_shape_names,
+                                    TUNE_SHAPES);
+        myc_backend backend = backend_from_name(backend_name);
+        tune_impl impl;
+        size_t k;
+
+        if (alg < 0 || shape < 0)
+            break;
+        for (k = 0; tune_describe(alg, shape, k, &impl); k++) {
+            if (impl.backend == backend && impl.features == impl_features
+                && impl.lanes == lanes && DISPATCH_SUPPORTED(impl, features)
+                && (shape == 0 || (impl.classes & (1u << (shape - 1)))))
+                break;
+        }
+        if (!tune_describe(alg, shape, k, &impl))
+            break;
+        if (dispatch_tuned[alg][shape] == 0)
+            loaded++;
+        dispatch_tuned[alg][shape] = (unsigned int) k + 1;
+    }
+
+    fclose(f);
+    return loaded == MYC_HASH_COUNT * TUNE_SHAPES ? 0 : -1;
+}
+
+static int tune_save(const char *path, unsigned int features)
+{
+    int alg, shape, ret;
+    FILE *f;
+
+    f = fopen(path, "w");
+    if (f == NULL)
+        return -1;
+
+    fprintf(f, "myc_hashing_tune %u %x\n", TUNE_VERSION, features);
+    for (alg = 0; alg < MYC_HASH_COUNT; alg++) {
+        for (shape = 0; shape < TUNE_SHAPES; shape++) {
+            tune_impl impl;
+
+            tune_describe(alg, shape, dispatch_tuned[alg][shape] - 1, &impl);
+            fprintf(f, "%s %s %s %x %u\n", tune_alg_names[alg],
+                    tune_shape_names[shape], backend_names[impl.backend],
+                    impl.features, impl.lanes);
+        }
+    }
+
+    ret = ferror(f) ? -1 : 0;
+    if (fclose(f) != 0)
+        ret = -1;
+    return ret;
+}
+
+static int dispatch_tune(const char *cache_path)
+{
+    unsigned int features = myc_cpu_features();
+
+    memset(dispatch_tuned, 0, sizeof(dispatch_tuned));
+    if (cache_path != NULL && tune_load(cache_path, features) == 0)
+        return 1;
+
+    memset(dispatch_tuned, 0, sizeof(dispatch_tuned));
+    tune_measure(features);
+    if (cache_path != NULL && tune_save(cache_path, features) != 0)
+        return -1;
+    return 0;
+}
+
+static void dispatch_init_once(void)
+{
+    const char *env;
+    int i;
+
+    DISPATCH_LOCK();
+    env = getenv("MYC_HASHING_BACKEND");
+    if (env != NULL) {
+        for (i = 0; i < MYC_HASH_COUNT; i++) {
+            dispatch_cap[i] = backend_from_name(env);
+        }
+    }
+
+    /* Its value names the cache file, none when empty */
+    env = getenv("MYC_HASHING_AUTOTUNE");
+    if (env != NULL)
+        dispatch_tune(*env != '\0' ? env : NULL);
+
+    dispatch_bind();
+    DISPATCH_UNLOCK();
+}
+
+void myc_dispatch_init(void)
+{
+#if MYC_HAVE_PTHREAD
+    pthread_once(&dispatch_once, dispatch_init_once);
+#else
+    if (dispatch_ready)
+        return;
+    dispatch_init_once();
+    dispatch_ready = 1;
+#endif
+}
+
+int myc_dispatch_set_backend(myc_hash_alg alg, myc_backend backend)
+{
+    int i;
+
+    if (backend < MYC_BACKEND_AUTO || backend > MYC_BACKEND_SHANI)
+        return -1;
+    if (alg < 0 || alg > MYC_HASH_ALL)
+        return -1;
+
+    myc_dispatch_init();
+    DISPATCH_LOCK();
+    for (i = 0; i < MYC_HASH_COUNT; i++) {
+        if (alg == MYC_HASH_ALL || alg == (myc_hash_alg) i)
+            dispatch_cap[i] = backend;
+    }
+    dispatch_bind();
+    DISPATCH_UNLOCK();
+
+    return 0;
+}
+
+int myc_dispatch_autotune(const char *cache_path)
+{
+    int ret;
+
+    myc_dispatch_init();
+    DISPATCH_LOCK();
+    ret = dispatch_tune(cache_path);
+    dispatch_bind();
+    DISPATCH_UNLOCK();
+
+    return ret;
+}
+
+myc_backend myc_dispatch_backend(myc_hash_alg alg)
+{
+    if (alg < 0 || alg >= MYC_HASH_COUNT)
+        return MYC_BACKEND_AUTO;
+
+    myc_dispatch_init();
+    return dispatch_bound[alg];
+}
+
+const char *myc_dispatch_backend_name(myc_backend backend)
+{
+    if (backend < MYC_BACKEND_AUTO || backend > MYC_BACKEND_SHANI)
+        return NULL;
+
+    return backend_names[backend];
+}
+
+/* First calls land here and bind the table */
+
+static void sha256_transf_resolve(uint32 *h, const unsigned char *message,
+                                  size_t block_nb)
+{
+    myc_dispatch_init();
+    myc_dispatch.sha256_transf(h, message, block_nb);
+}
+
+static void sha512_transf_resolve(uint64 *h, const unsigned char *message,
+                                  size_t block_nb)
+{
+    myc_dispatch_init();
+    myc_dispatch.sha512_transf(h, message, block_nb);
+}
+
+static void sha3_permutation_resolve(uint64_t *state)
+{
+    myc_dispatch_init();
+    myc_dispatch.sha3_permutation(state);
+}
+
+static void ripemd160_process_resolve(uint32_t *state, const uint8_t *data,
+                                      size_t block_nb)
+{
+    myc_dispatch_init();
+    myc_dispatch.ripemd160_process(state, data, block_nb);
+}
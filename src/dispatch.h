@@ -0,0 +1,164 @@
+/*
+ * Compression function backends
+ *
+ * Internal header shared by the hash implementations and the CPU
+ * specific kernels. Every block transform processes block_nb
+ * consecutive blocks and updates the chaining state in place. The
+ * myc_dispatch table holds the implementation bound for this CPU.
+ */
+
+#ifndef MYC_DISPATCH_H
+#define MYC_DISPATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cpu_dispatch.h"
+#include "ripemd160.h"
+#include "sha2.h"
+#include "sha3.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MYC_X86 1
+#endif
+
+typedef void (*sha256_transf_fn)(uint32 *h, const unsigned char *message,
+                                 size_t block_nb);
+typedef void (*sha512_transf_fn)(uint64 *h, const unsigned char *message,
+                                 size_t block_nb);
+typedef void (*sha3_permutation_fn)(uint64_t *state);
+typedef void (*ripemd160_process_fn)(uint32_t *state, const uint8_t *data,
+                                     size_t block_nb);
+
+/*
+ * Multi-buffer transforms run block_nb blocks of several independent
+ * streams at once, lane l reading its blocks from data[l]. The state
+ * is word-major: word i of lane l is state[i * lanes + l].
+ */
+typedef void (*sha256_mb_fn)(uint32 *state, const unsigned char *const *data,
+                             size_t block_nb);
+typedef void (*sha512_mb_fn)(uint64 *state, const unsigned char *const *data,
+                             size_t block_nb);
+/* Permutation of every state, the absorbing being left to the caller */
+typedef void (*sha3_mb_fn)(uint64_t *state);
+typedef void (*ripemd160_mb_fn)(uint32_t *state, const uint8_t *const *data,
+                                size_t block_nb);
+
+/* NULL with 1 lane when messages are best hashed one at a time */
+typedef struct {
+    sha256_mb_fn fn;
+    unsigned int lanes;
+} sha256_mb_impl;
+
+typedef struct {
+    sha512_mb_fn fn;
+    unsigned int lanes;
+} sha512_mb_impl;
+
+typedef struct {
+    sha3_mb_fn fn;
+    unsigned int lanes;
+} sha3_mb_impl;
+
+typedef struct {
+    ripemd160_mb_fn fn;
+    unsigned int lanes;
+} ripemd160_mb_impl;
+
+/*
+ * Batches are split in size classes, each with its own multi-buffer
+ * binding, so that wide engines only serve batches that fill them.
+ */
+#define MYC_BATCH_SMALL 0
+#define MYC_BATCH_LARGE 1           /* at least MYC_BATCH_LARGE_MIN */
+#define MYC_BATCH_CLASSES 2
+
+#define MYC_BATCH_LARGE_MIN 64
+
+#define MYC_BATCH_CLASS(count) \
+    ((count) >= MYC_BATCH_LARGE_MIN ? MYC_BATCH_LARGE : MYC_BATCH_SMALL)
+
+typedef struct {
+    sha256_transf_fn sha256_transf;
+    sha512_transf_fn sha512_transf;
+    sha3_permutation_fn sha3_permutation;
+    ripemd160_process_fn ripemd160_process;
+
+    sha256_mb_impl sha256_mb[MYC_BATCH_CLASSES];
+    sha512_mb_impl sha512_mb[MYC_BATCH_CLASSES];
+    sha3_mb_impl sha3_mb[MYC_BATCH_CLASSES];
+    ripemd160_mb_impl ripemd160_mb[MYC_BATCH_CLASSES];
+} myc_dispatch_table;
+
+extern myc_dispatch_table myc_dispatch;
+
+/* Bind the table, only needed before reading the multi-buffer entries */
+void myc_dispatch_init(void);
+
+/* SHA-224/256 */
+extern uint32 sha224_h0[8];
+extern uint32 sha256_h0[8];
+extern uint32 sha256_k[64];
+
+void sha256_transf_c(uint32 *h, const unsigned char *message, size_t block_nb);
+void sha256_transf_x2_c(uint32 *state, const unsigned char *const *data,
+                        size_t block_nb);
+#ifdef MYC_X86
+void sha256_transf_shani(uint32 *h, const unsigned char *message,
+                         size_t block_nb);
+void sha256_transf_avx2(uint32 *h, const unsigned char *message,
+                        size_t block_nb);
+void sha256_transf_avx(uint32 *h, const unsigned char *message,
+                       size_t block_nb);
+void sha256_transf_ssse3(uint32 *h, const unsigned char *message,
+                         size_t block_nb);
+void sha256_transf_x8_avx2(uint32 *state, const unsigned char *const *data,
+                           size_t block_nb);
+void sha256_transf_x16_avx512(uint32 *state, const unsigned char *const *data,
+                              size_t block_nb);
+#endif
+
+/* SHA-384/512 */
+extern uint64 sha384_h0[8];
+extern uint64 sha512_h0[8];
+extern uint64 sha512_k[80];
+
+void sha512_transf_c(uint64 *h, const unsigned char *message, size_t block_nb);
+#ifdef MYC_X86
+void sha512_transf_avx2(uint64 *h, const unsigned char *message,
+                        size_t block_nb);
+void sha512_transf_x4_avx2(uint64 *state, const unsigned char *const *data,
+                           size_t block_nb);
+void sha512_transf_x8_avx512(uint64 *state, const unsigned char *const *data,
+                             size_t block_nb);
+#endif
+
+/* Keccak-f[1600] */
+extern uint64_t myc_keccak_round_constants[24];
+
+void myc_sha3_permutation_c(uint64_t *state);
+#ifdef MYC_X86
+void myc_sha3_permutation_bmi1(uint64_t *state);
+void myc_sha3_permutation_avx512(uint64_t *state);
+void myc_sha3_permutation_x4_avx2(uint64_t *state);
+void myc_sha3_permutation_x8_avx512(uint64_t *state);
+#endif
+
+/* RIPEMD-160 */
+void myc_ripemd160_process_c(uint32_t *state, const uint8_t *data,
+                             size_t block_nb);
+void myc_ripemd160_process_x2_c(uint32_t *state, const uint8_t *const *data,
+                                size_t block_nb);
+#ifdef MYC_X86
+void myc_ripemd160_process_x4_sse2(uint32_t *state,
+                                   const uint8_t *const *data,
+                                   size_t block_nb);
+void myc_ripemd160_process_x8_avx2(uint32_t *state,
+                                   const uint8_t *const *data,
+                                   size_t block_nb);
+void myc_ripemd160_process_x16_avx512(uint32_t *state,
+                                      const uint8_t *const *data,
+                                      size_t block_nb);
+#endif
+
+#endif /* !MYC_DISPATCH_H */
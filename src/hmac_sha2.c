@@ -38,7 +38,7 @@
 /* HMAC-SHA-224 functions */
 
 void myc_hmac_sha224_init(myc_hmac_sha224_ctx *ctx, const unsigned char *key,
-                      unsigned int key_size)
+                      size_t key_size)
 {
     unsigned int fill;
     unsigned int num;
@@ -93,11 +93,17 @@ void myc_hmac_sha224_reinit(myc_hmac_sha224_ctx *ctx)
 }
 
 void myc_hmac_sha224_update(myc_hmac_sha224_ctx *ctx, const unsigned char *message,
-                        unsigned int message_len)
+                        size_t message_len)
 {
     myc_sha224_update(&ctx->ctx_inside, message, message_len);
 }
 
+void myc_hmac_sha224_updatev(myc_hmac_sha224_ctx *ctx, const struct iovec *iov,
+                             int cnt)
+{
+    myc_sha224_updatev(&ctx->ctx_inside, iov, cnt);
+}
+
 void myc_hmac_sha224_final(myc_hmac_sha224_ctx *ctx, unsigned char *mac,
                        unsigned int mac_size)
 {
@@ -110,8 +116,8 @@ void myc_hmac_sha224_final(myc_hmac_sha224_ctx *ctx, unsigned char *mac,
     memcpy(mac, mac_temp, mac_size);
 }
 
-void myc_hmac_sha224(const unsigned char *key, unsigned int key_size,
-          const unsigned char *message, unsigned int message_len,
+void myc_hmac_sha224(const unsigned char *key, size_t key_size,
+          const unsigned char *message, size_t message_len,
           unsigned char *mac, unsigned mac_size)
 {
     myc_hmac_sha224_ctx ctx;
@@ -124,7 +130,7 @@ void myc_hmac_sha224(const unsigned char *key, unsigned int key_size,
 /* HMAC-SHA-256 functions */
 
 void myc_hmac_sha256_init(myc_hmac_sha256_ctx *ctx, const unsigned char *key,
-                      unsigned int key_size)
+                      size_t key_size)
 {
     unsigned int fill;
     unsigned int num;
@@ -179,11 +185,17 @@ void myc_hmac_sha256_reinit(myc_hmac_sha256_ctx *ctx)
 }
 
 void myc_hmac_sha256_update(myc_hmac_sha256_ctx *ctx, const unsigned char *message,
-                        unsigned int message_len)
+                        size_t message_len)
 {
     myc_sha256_update(&ctx->ctx_inside, message, message_len);
 }
 
+void myc_hmac_sha256_updatev(myc_hmac_sha256_ctx *ctx, const struct iovec *iov,
+                             int cnt)
+{
+    myc_sha256_updatev(&ctx->ctx_inside, iov, cnt);
+}
+
 void myc_hmac_sha256_final(myc_hmac_sha256_ctx *ctx, unsigned char *mac,
                        unsigned int mac_size)
 {
@@ -196,8 +208,8 @@ void myc_hmac_sha256_final(myc_hmac_sha256_ctx *ctx, unsigned char *mac,
     memcpy(mac, mac_temp, mac_size);
 }
 
-void myc_hmac_sha256(const unsigned char *key, unsigned int key_size,
-          const unsigned char *message, unsigned int message_len,
+void myc_hmac_sha256(const unsigned char *key, size_t key_size,
+          const unsigned char *message, size_t message_len,
           unsigned char *mac, unsigned mac_size)
 {
     myc_hmac_sha256_ctx ctx;
@@ -210,7 +222,7 @@ void myc_hmac_sha256(const unsigned char *key, unsigned int key_size,
 /* HMAC-SHA-384 functions */
 
 void myc_hmac_sha384_init(myc_hmac_sha384_ctx *ctx, const unsigned char *key,
-                      unsigned int key_size)
+                      size_t key_size)
 {
     unsigned int fill;
     unsigned int num;
@@ -265,11 +277,17 @@ void myc_hmac_sha384_reinit(myc_hmac_sha384_ctx *ctx)
 }
 
 void myc_hmac_sha384_update(myc_hmac_sha384_ctx *ctx, const unsigned char *message,
-                        unsigned int message_len)
+                        size_t message_len)
 {
     myc_sha384_update(&ctx->ctx_inside, message, message_len);
 }
 
+void myc_hmac_sha384_updatev(myc_hmac_sha384_ctx *ctx, const struct iovec *iov,
+                             int cnt)
+{
+    myc_sha384_updatev(&ctx->ctx_inside, iov, cnt);
+}
+
 void myc_hmac_sha384_final(myc_hmac_sha384_ctx *ctx, unsigned char *mac,
                        unsigned int mac_size)
 {
@@ -282,8 +300,8 @@ void myc_hmac_sha384_final(myc_hmac_sha384_ctx *ctx, unsigned char *mac,
     memcpy(mac, mac_temp, mac_size);
 }
 
-void myc_hmac_sha384(const unsigned char *key, unsigned int key_size,
-          const unsigned char *message, unsigned int message_len,
+void myc_hmac_sha384(const unsigned char *key, size_t key_size,
+          const unsigned char *message, size_t message_len,
           unsigned char *mac, unsigned mac_size)
 {
     myc_hmac_sha384_ctx ctx;
@@ -296,7 +314,7 @@ void myc_hmac_sha384(const unsigned char *key, unsigned int key_size,
 /* HMAC-SHA-512 functions */
 
 void myc_hmac_sha512_init(myc_hmac_sha512_ctx *ctx, const unsigned char *key,
-                      unsigned int key_size)
+                      size_t key_size)
 {
     unsigned int fill;
     unsigned int num;
@@ -351,11 +369,17 @@ void myc_hmac_sha512_reinit(myc_hmac_sha512_ctx *ctx)
 }
 
 void myc_hmac_sha512_update(myc_hmac_sha512_ctx *ctx, const unsigned char *message,
-                        unsigned int message_len)
+                        size_t message_len)
 {
     myc_sha512_update(&ctx->ctx_inside, message, message_len);
 }
 
+void myc_hmac_sha512_updatev(myc_hmac_sha512_ctx *ctx, const struct iovec *iov,
+                             int cnt)
+{
+    myc_sha512_updatev(&ctx->ctx_inside, iov, cnt);
+}
+
 void myc_hmac_sha512_final(myc_hmac_sha512_ctx *ctx, unsigned char *mac,
                        unsigned int mac_size)
 {
@@ -368,8 +392,8 @@ void myc_hmac_sha512_final(myc_hmac_sha512_ctx *ctx, unsigned char *mac,
     memcpy(mac, mac_temp, mac_size);
 }
 
-void myc_hmac_sha512(const unsigned char *key, unsigned int key_size,
-          const unsigned char *message, unsigned int message_len,
+void myc_hmac_sha512(const unsigned char *key, size_t key_size,
+          const unsigned char *message, size_t message_len,
           unsigned char *mac, unsigned mac_size)
 {
     myc_hmac_sha512_ctx ctx;
@@ -100,6 +100,12 @@ void myc_hmac_sha3_224_update(myc_hmac_sha3_224_ctx *ctx, const unsigned char *m
     myc_sha3_Update(&ctx->ctx_inside, message, message_len);
 }
 
+void myc_hmac_sha3_224_updatev(myc_hmac_sha3_224_ctx *ctx, const struct iovec *iov,
+                               int cnt)
+{
+    myc_sha3_Updatev(&ctx->ctx_inside, iov, cnt);
+}
+
 void myc_hmac_sha3_224_final(myc_hmac_sha3_224_ctx *ctx, unsigned char *mac,
                        unsigned int mac_size)
 {
@@ -186,6 +192,12 @@ void myc_hmac_sha3_256_update(myc_hmac_sha3_256_ctx *ctx, const unsigned char *m
     myc_sha3_Update(&ctx->ctx_inside, message, message_len);
 }
 
+void myc_hmac_sha3_256_updatev(myc_hmac_sha3_256_ctx *ctx, const struct iovec *iov,
+                               int cnt)
+{
+    myc_sha3_Updatev(&ctx->ctx_inside, iov, cnt);
+}
+
 void myc_hmac_sha3_256_final(myc_hmac_sha3_256_ctx *ctx, unsigned char *mac,
                        unsigned int mac_size)
 {
@@ -272,6 +284,12 @@ void myc_hmac_sha3_384_update(myc_hmac_sha3_384_ctx *ctx, const unsigned char *m
     myc_sha3_Update(&ctx->ctx_inside, message, message_len);
 }
 
+void myc_hmac_sha3_384_updatev(myc_hmac_sha3_384_ctx *ctx, const struct iovec *iov,
+                               int cnt)
+{
+    myc_sha3_Updatev(&ctx->ctx_inside, iov, cnt);
+}
+
 void myc_hmac_sha3_384_final(myc_hmac_sha3_384_ctx *ctx, unsigned char *mac,
                        unsigned int mac_size)
 {
@@ -358,6 +376,12 @@ void myc_hmac_sha3_512_update(myc_hmac_sha3_512_ctx *ctx, const unsigned char *m
     myc_sha3_Update(&ctx->ctx_inside, message, message_len);
 }
 
+void myc_hmac_sha3_512_updatev(myc_hmac_sha3_512_ctx *ctx, const struct iovec *iov,
+                               int cnt)
+{
+    myc_sha3_Updatev(&ctx->ctx_inside, iov, cnt);
+}
+
 void myc_hmac_sha3_512_final(myc_hmac_sha3_512_ctx *ctx, unsigned char *mac,
                        unsigned int mac_size)
 {
@@ -0,0 +1,116 @@
+/*
+ * Keccak-f[1600] round shared by the scalar and SIMD permutations
+ *
+ * The 25 lanes are local variables named after their row (b, g, k, m,
+ * s) and column (a, e, i, o, u), A##ba being lane 0 and A##su lane 24.
+ * A round goes from the lanes A.. to the lanes E.., merging theta, rho,
+ * pi, chi and iota so that every lane is read and written once. The
+ * includer defines the lane operations for its lane type:
+ *
+ *   KECCAK_XOR(x, y)           x ^ y
+ *   KECCAK_XOR5(a, b, c, d, e) a ^ b ^ c ^ d ^ e
+ *   KECCAK_ROL(x, n)           rotation left by 0 < n < 64
+ *   KECCAK_CHI(x, y, z)        x ^ (~y & z)
+ */
+
+#ifndef MYC_KECCAK_ROUND_H
+#define MYC_KECCAK_ROUND_H
+
+#define KECCAK_LANES(type, A)                                           \
+    type A##ba, A##be, A##bi, A##bo, A##bu;                             \
+    type A##ga, A##ge, A##gi, A##go, A##gu;                             \
+    type A##ka, A##ke, A##ki, A##ko, A##ku;                             \
+    type A##ma, A##me, A##mi, A##mo, A##mu;                             \
+    type A##sa, A##se, A##si, A##so, A##su
+
+/* Temporaries used by KECCAK_ROUND() */
+#define KECCAK_TEMPS(type)                                              \
+    type Ba, Be, Bi, Bo, Bu;                                            \
+    type Ca, Ce, Ci, Co, Cu;                                            \
+    type Da, De, Di, Do, Du
+
+/* OP(lane, index) for every lane */
+#define KECCAK_MAP(A, OP)                                               \
+{                                                                       \
+    OP(A##ba,  0); OP(A##be,  1); OP(A##bi,  2);                        \
+    OP(A##bo,  3); OP(A##bu,  4);                                       \
+    OP(A##ga,  5); OP(A##ge,  6); OP(A##gi,  7);                        \
+    OP(A##go,  8); OP(A##gu,  9);                                       \
+    OP(A##ka, 10); OP(A##ke, 11); OP(A##ki, 12);                        \
+    OP(A##ko, 13); OP(A##ku, 14);                                       \
+    OP(A##ma, 15); OP(A##me, 16); OP(A##mi, 17);                        \
+    OP(A##mo, 18); OP(A##mu, 19);                                       \
+    OP(A##sa, 20); OP(A##se, 21); OP(A##si, 22);                        \
+    OP(A##so, 23); OP(A##su, 24);                                       \
+}
+
+#define KECCAK_ROUND(A, E, rc)                                          \
+{                                                                       \
+    Ca = KECCAK_XOR5(A##ba, A##ga, A##ka, A##ma, A##sa);                \
+    Ce = KECCAK_XOR5(A##be, A##ge, A##ke, A##me, A##se);                \
+    Ci = KECCAK_XOR5(A##bi, A##gi, A##ki, A##mi, A##si);                \
+    Co = KECCAK_XOR5(A##bo, A##go, A##ko, A##mo, A##so);                \
+    Cu = KECCAK_XOR5(A##bu, A##gu, A##ku, A##mu, A##su);                \
+    Da = KECCAK_XOR(Cu, KECCAK_ROL(Ce, 1));                             \
+    De = KECCAK_XOR(Ca, KECCAK_ROL(Ci, 1));                             \
+    Di = KECCAK_XOR(Ce, KECCAK_ROL(Co, 1));                             \
+    Do = KECCAK_XOR(Ci, KECCAK_ROL(Cu, 1));                             \
+    Du = KECCAK_XOR(Co, KECCAK_ROL(Ca, 1));                             \
+                                                                        \
+    Ba = KECCAK_XOR(A##ba, Da);                                         \
+    Be = KECCAK_ROL(KECCAK_XOR(A##ge, De), 44);                         \
+    Bi = KECCAK_ROL(KECCAK_XOR(A##ki, Di), 43);                         \
+    Bo = KECCAK_ROL(KECCAK_XOR(A##mo, Do), 21);                         \
+    Bu = KECCAK_ROL(KECCAK_XOR(A##su, Du), 14);                         \
+    E##ba = KECCAK_XOR(KECCAK_CHI(Ba, Be, Bi), rc);                     \
+    E##be = KECCAK_CHI(Be, Bi, Bo);                                     \
+    E##bi = KECCAK_CHI(Bi, Bo, Bu);                                     \
+    E##bo = KECCAK_CHI(Bo, Bu, Ba);                                     \
+    E##bu = KECCAK_CHI(Bu, Ba, Be);                                     \
+                                                                        \
+    Ba = KECCAK_ROL(KECCAK_XOR(A##bo, Do), 28);                         \
+    Be = KECCAK_ROL(KECCAK_XOR(A##gu, Du), 20);                         \
+    Bi = KECCAK_ROL(KECCAK_XOR(A##ka, Da), 3);                          \
+    Bo = KECCAK_ROL(KECCAK_XOR(A##me, De), 45);                         \
+    Bu = KECCAK_ROL(KECCAK_XOR(A##si, Di), 61);                         \
+    E##ga = KECCAK_CHI(Ba, Be, Bi);                                     \
+    E##ge = KECCAK_CHI(Be, Bi, Bo);                                     \
+    E##gi = KECCAK_CHI(Bi, Bo, Bu);                                     \
+    E##go = KECCAK_CHI(Bo, Bu, Ba);                                     \
+    E##gu = KECCAK_CHI(Bu, Ba, Be);                                     \
+                                                                        \
+    Ba = KECCAK_ROL(KECCAK_XOR(A##be, De), 1);                          \
+    Be = KECCAK_ROL(KECCAK_XOR(A##gi, Di), 6);                          \
+    Bi = KECCAK_ROL(KECCAK_XOR(A##ko, Do), 25);                         \
+    Bo = KECCAK_ROL(KECCAK_XOR(A##mu, Du), 8);                          \
+    Bu = KECCAK_ROL(KECCAK_XOR(A##sa, Da), 18);                         \
+    E##ka = KECCAK_CHI(Ba, Be, Bi);                                     \
+    E##ke = KECCAK_CHI(Be, Bi, Bo);                                     \
+    E##ki = KECCAK_CHI(Bi, Bo, Bu);                                     \
+    E##ko = KECCAK_CHI(Bo, Bu, Ba);                                     \
+    E##ku = KECCAK_CHI(Bu, Ba, Be);                                     \
+                                                                        \
+    Ba = KECCAK_ROL(KECCAK_XOR(A##bu, Du), 27);                         \
+    Be = KECCAK_ROL(KECCAK_XOR(A##ga, Da), 36);                         \
+    Bi = KECCAK_ROL(KECCAK_XOR(A##ke, De), 10);                         \
+    Bo = KECCAK_ROL(KECCAK_XOR(A##mi, Di), 15);                         \
+    Bu = KECCAK_ROL(KECCAK_XOR(A##so, Do), 56);                         \
+    E##ma = KECCAK_CHI(Ba, Be, Bi);                                     \
+    E##me = KECCAK_CHI(Be, Bi, Bo);                                     \
+    E##mi = KECCAK_CHI(Bi, Bo, Bu);                                     \
+    E##mo = KECCAK_CHI(Bo, Bu, Ba);                                     \
+    E##mu = KECCAK_CHI(Bu, Ba, Be);                                     \
+                                                                        \
+    Ba = KECCAK_ROL(KECCAK_XOR(A##bi, Di), 62);                         \
+    Be = KECCAK_ROL(KECCAK_XOR(A##go, Do), 55);                         \
+    Bi = KECCAK_ROL(KECCAK_XOR(A##ku, Du), 39);                         \
+    Bo = KECCAK_ROL(KECCAK_XOR(A##ma, Da), 41);                         \
+    Bu = KECCAK_ROL(KECCAK_XOR(A##se, De), 2);                          \
+    E##sa = KECCAK_CHI(Ba, Be, Bi);                                     \
+    E##se = KECCAK_CHI(Be, Bi, Bo);                                     \
+    E##si = KECCAK_CHI(Bi, Bo, Bu);                                     \
+    E##so = KECCAK_CHI(Bo, Bu, Ba);                                     \
+    E##su = KECCAK_CHI(Bu, Ba, Be);                                     \
+}
+
+#endif /* !MYC_KECCAK_ROUND_H */
@@ -0,0 +1,79 @@
+/*
+ * Message streams of the Merkle-Damgard batch hashing
+ */
+
+#include <string.h>
+
+#include "md_lane.h"
+
+/*
+ * The length field takes the last 8 bytes of a 64-byte block and the
+ * last 16 bytes of a 128-byte block, its high half being zero.
+ */
+void md_lane_init(md_lane *lane, const unsigned char *message, size_t len,
+                  size_t block_size, int little_endian)
+{
+    size_t len_size = block_size == MD_LANE_MAX_BLOCK ? 16 : 8;
+    size_t rem = len % block_size;
+    unsigned long long len_b = (unsigned long long) len << 3;
+    unsigned char *end;
+    int i;
+
+    lane->tail_nb = rem < block_size - len_size ? 1 : 2;
+    /* an empty message may be NULL */
+    if (rem != 0)
+        memcpy(lane->tail, message + len - rem, rem);
+    memset(lane->tail + rem, 0, lane->tail_nb * block_size - rem);
+    lane->tail[rem] = 0x80;
+
+    end = lane->tail + lane->tail_nb * block_size;
+    for (i = 1; i <= 8; i++) {
+        end[little_endian ? i - 9 : -i] = (unsigned char) len_b;
+        len_b >>= 8;
+    }
+
+    lane->data = message;
+    lane->block_nb = len / block_size;
+    lane->in_tail = 0;
+    if (lane->block_nb == 0) {
+        lane->data = lane->tail;
+        lane->block_nb = lane->tail_nb;
+        lane->in_tail = 1;
+    }
+}
+
+int md_lane_advance(md_lane *lane, size_t block_nb, size_t block_size)
+{
+    lane->data += block_nb * block_size;
+    lane->block_nb -= block_nb;
+    if (lane->block_nb > 0)
+        return 1;
+    if (lane->in_tail)
+        return 0;
+
+    lane->data = lane->tail;
+    lane->block_nb = lane->tail_nb;
+    lane->in_tail = 1;
+    return 1;
+}
+
+size_t md_lanes_next(const md_lane *lanes, const int *active,
+                     unsigned int lane_nb, const unsigned char **data)
+{
+    size_t block_nb = 0;
+    unsigned int first = 0;
+    unsigned int l;
+
+    for (l = lane_nb; l-- > 0; ) {
+        if (active[l] && (block_nb == 0 || lanes[l].block_nb < block_nb)) {
+            block_nb = lanes[l].block_nb;
+        }
+        if (active[l])
+            first = l;
+    }
+    for (l = 0; l < lane_nb; l++) {
+        data[l] = active[l] ? lanes[l].data : lanes[first].data;
+    }
+
+    return block_nb;
+}
@@ -0,0 +1,43 @@
+/*
+ * Message streams of the Merkle-Damgard batch hashing
+ *
+ * A lane walks over the full blocks of its message in place, then over
+ * one or two padded final blocks prepared in its tail buffer, so that
+ * the multi-buffer transforms always read whole blocks.
+ */
+
+#ifndef MYC_MD_LANE_H
+#define MYC_MD_LANE_H
+
+#include <stddef.h>
+
+/* Largest block size, that of SHA-384/512 */
+#define MD_LANE_MAX_BLOCK 128
+
+typedef struct {
+    const unsigned char *data;  /* next block to hash */
+    size_t block_nb;            /* blocks left at data */
+    int in_tail;                /* data points into tail */
+    unsigned char tail[2 * MD_LANE_MAX_BLOCK];
+    size_t tail_nb;
+} md_lane;
+
+/*
+ * Start a lane on a message of len bytes. The bit length is stored
+ * big-endian for SHA-2 and little-endian for RIPEMD-160.
+ */
+void md_lane_init(md_lane *lane, const unsigned char *message, size_t len,
+                  size_t block_size, int little_endian);
+
+/* Advance a lane by block_nb blocks, returns 0 once it is finished */
+int md_lane_advance(md_lane *lane, size_t block_nb, size_t block_size);
+
+/*
+ * Fill data with the input of every lane and return how many blocks
+ * all active lanes can run before one of them reaches the end of its
+ * input. At least one lane is active.
+ */
+size_t md_lanes_next(const md_lane *lanes, const int *active,
+                     unsigned int lane_nb, const unsigned char **data);
+
+#endif /* !MYC_MD_LANE_H */
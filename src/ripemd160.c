@@ -26,8 +26,9 @@
  */
 
 #include <string.h>
+#include <sys/uio.h>
 
-#include "ripemd160.h"
+#include "dispatch.h"
 
 /*
  * 32-bit integer manipulation macros (little endian)
@@ -67,36 +68,37 @@ void myc_ripemd160_Init(MYC_RIPEMD160_CTX *ctx)
     ctx->state[4] = 0xC3D2E1F0;
 }
 
-#if !defined(MBEDTLS_RIPEMD160_PROCESS_ALT)
 /*
- * Process one block
+ * Process block_nb consecutive blocks
  */
-void myc_ripemd160_process( MYC_RIPEMD160_CTX *ctx, const uint8_t data[MYC_RIPEMD160_BLOCK_LENGTH] )
+void myc_ripemd160_process_c( uint32_t *state, const uint8_t *data, size_t block_nb )
 {
     uint32_t A, B, C, D, E, Ap, Bp, Cp, Dp, Ep, X[16];
 
-    GET_UINT32_LE( X[ 0], data,  0 );
-    GET_UINT32_LE( X[ 1], data,  4 );
-    GET_UINT32_LE( X[ 2], data,  8 );
-    GET_UINT32_LE( X[ 3], data, 12 );
-    GET_UINT32_LE( X[ 4], data, 16 );
-    GET_UINT32_LE( X[ 5], data, 20 );
-    GET_UINT32_LE( X[ 6], data, 24 );
-    GET_UINT32_LE( X[ 7], data, 28 );
-    GET_UINT32_LE( X[ 8], data, 32 );
-    GET_UINT32_LE( X[ 9], data, 36 );
-    GET_UINT32_LE( X[10], data, 40 );
-    GET_UINT32_LE( X[11], data, 44 );
-    GET_UINT32_LE( X[12], data, 48 );
-    GET_UINT32_LE( X[13], data, 52 );
-    GET_UINT32_LE( X[14], data, 56 );
-    GET_UINT32_LE( X[15], data, 60 );
-
-    A = Ap = ctx->state[0];
-    B = Bp = ctx->state[1];
-    C = Cp = ctx->state[2];
-    D = Dp = ctx->state[3];
-    E = Ep = ctx->state[4];
+    for( ; block_nb > 0; block_nb--, data += MYC_RIPEMD160_BLOCK_LENGTH )
+    {
+        GET_UINT32_LE( X[ 0], data,  0 );
+        GET_UINT32_LE( X[ 1], data,  4 );
+        GET_UINT32_LE( X[ 2], data,  8 );
+        GET_UINT32_LE( X[ 3], data, 12 );
+        GET_UINT32_LE( X[ 4], data, 16 );
+        GET_UINT32_LE( X[ 5], data, 20 );
+        GET_UINT32_LE( X[ 6], data, 24 );
+        GET_UINT32_LE( X[ 7], data, 28 );
+        GET_UINT32_LE( X[ 8], data, 32 );
+        GET_UINT32_LE( X[ 9], data, 36 );
+        GET_UINT32_LE( X[10], data, 40 );
+        GET_UINT32_LE( X[11], data, 44 );
+        GET_UINT32_LE( X[12], data, 48 );
+        GET_UINT32_LE( X[13], data, 52 );
+        GET_UINT32_LE( X[14], data, 56 );
+        GET_UINT32_LE( X[15], data, 60 );
+
+        A = Ap = state[0];
+        B = Bp = state[1];
+        C = Cp = state[2];
+        D = Dp = state[3];
+        E = Ep = state[4];
 
 #define F1( x, y, z )   ( x ^ y ^ z )
 #define F2( x, y, z )   ( ( x & y ) | ( ~x & z ) )
@@ -119,22 +121,22 @@ void myc_ripemd160_process( MYC_RIPEMD160_CTX *ctx, const uint8_t data[MYC_RIPEM
 #define K   0x00000000
 #define Fp  F5
 #define Kp  0x50A28BE6
-    P2( A, B, C, D, E,  0, 11,  5,  8 );
-    P2( E, A, B, C, D,  1, 14, 14,  9 );
-    P2( D, E, A, B, C,  2, 15,  7,  9 );
-    P2( C, D, E, A, B,  3, 12,  0, 11 );
-    P2( B, C, D, E, A,  4,  5,  9, 13 );
-    P2( A, B, C, D, E,  5,  8,  2, 15 );
-    P2( E, A, B, C, D,  6,  7, 11, 15 );
-    P2( D, E, A, B, C,  7,  9,  4,  5 );
-    P2( C, D, E, A, B,  8, 11, 13,  7 );
-    P2( B, C, D, E, A,  9, 13,  6,  7 );
-    P2( A, B, C, D, E, 10, 14, 15,  8 );
-    P2( E, A, B, C, D, 11, 15,  8, 11 );
-    P2( D, E, A, B, C, 12,  6,  1, 14 );
-    P2( C, D, E, A, B, 13,  7, 10, 14 );
-    P2( B, C, D, E, A, 14,  9,  3, 12 );
-    P2( A, B, C, D, E, 15,  8, 12,  6 );
+        P2( A, B, C, D, E,  0, 11,  5,  8 );
+        P2( E, A, B, C, D,  1, 14, 14,  9 );
+        P2( D, E, A, B, C,  2, 15,  7,  9 );
+        P2( C, D, E, A, B,  3, 12,  0, 11 );
+        P2( B, C, D, E, A,  4,  5,  9, 13 );
+        P2( A, B, C, D, E,  5,  8,  2, 15 );
+        P2( E, A, B, C, D,  6,  7, 11, 15 );
+        P2( D, E, A, B, C,  7,  9,  4,  5 );
+        P2( C, D, E, A, B,  8, 11, 13,  7 );
+        P2( B, C, D, E, A,  9, 13,  6,  7 );
+        P2( A, B, C, D, E, 10, 14, 15,  8 );
+        P2( E, A, B, C, D, 11, 15,  8, 11 );
+        P2( D, E, A, B, C, 12,  6,  1, 14 );
+        P2( C, D, E, A, B, 13,  7, 10, 14 );
+        P2( B, C, D, E, A, 14,  9,  3, 12 );
+        P2( A, B, C, D, E, 15,  8, 12,  6 );
 #undef F
 #undef K
 #undef Fp
@@ -144,22 +146,22 @@ void myc_ripemd160_process( MYC_RIPEMD160_CTX *ctx, const uint8_t data[MYC_RIPEM
 #define K   0x5A827999
 #define Fp  F4
 #define Kp  0x5C4DD124
-    P2( E, A, B, C, D,  7,  7,  6,  9 );
-    P2( D, E, A, B, C,  4,  6, 11, 13 );
-    P2( C, D, E, A, B, 13,  8,  3, 15 );
-    P2( B, C, D, E, A,  1, 13,  7,  7 );
-    P2( A, B, C, D, E, 10, 11,  0, 12 );
-    P2( E, A, B, C, D,  6,  9, 13,  8 );
-    P2( D, E, A, B, C, 15,  7,  5,  9 );
-    P2( C, D, E, A, B,  3, 15, 10, 11 );
-    P2( B, C, D, E, A, 12,  7, 14,  7 );
-    P2( A, B, C, D, E,  0, 12, 15,  7 );
-    P2( E, A, B, C, D,  9, 15,  8, 12 );
-    P2( D, E, A, B, C,  5,  9, 12,  7 );
-    P2( C, D, E, A, B,  2, 11,  4,  6 );
-    P2( B, C, D, E, A, 14,  7,  9, 15 );
-    P2( A, B, C, D, E, 11, 13,  1, 13 );
-    P2( E, A, B, C, D,  8, 12,  2, 11 );
+        P2( E, A, B, C, D,  7,  7,  6,  9 );
+        P2( D, E, A, B, C,  4,  6, 11, 13 );
+        P2( C, D, E, A, B, 13,  8,  3, 15 );
+        P2( B, C, D, E, A,  1, 13,  7,  7 );
+        P2( A, B, C, D, E, 10, 11,  0, 12 );
+        P2( E, A, B, C, D,  6,  9, 13,  8 );
+        P2( D, E, A, B, C, 15,  7,  5,  9 );
+        P2( C, D, E, A, B,  3, 15, 10, 11 );
+        P2( B, C, D, E, A, 12,  7, 14,  7 );
+        P2( A, B, C, D, E,  0, 12, 15,  7 );
+        P2( E, A, B, C, D,  9, 15,  8, 12 );
+        P2( D, E, A, B, C,  5,  9, 12,  7 );
+        P2( C, D, E, A, B,  2, 11,  4,  6 );
+        P2( B, C, D, E, A, 14,  7,  9, 15 );
+        P2( A, B, C, D, E, 11, 13,  1, 13 );
+        P2( E, A, B, C, D,  8, 12,  2, 11 );
 #undef F
 #undef K
 #undef Fp
@@ -169,22 +171,22 @@ void myc_ripemd160_process( MYC_RIPEMD160_CTX *ctx, const uint8_t data[MYC_RIPEM
 #define K   0x6ED9EBA1
 #define Fp  F3
 #define Kp  0x6D703EF3
-    P2( D, E, A, B, C,  3, 11, 15,  9 );
-    P2( C, D, E, A, B, 10, 13,  5,  7 );
-    P2( B, C, D, E, A, 14,  6,  1, 15 );
-    P2( A, B, C, D, E,  4,  7,  3, 11 );
-    P2( E, A, B, C, D,  9, 14,  7,  8 );
-    P2( D, E, A, B, C, 15,  9, 14,  6 );
-    P2( C, D, E, A, B,  8, 13,  6,  6 );
-    P2( B, C, D, E, A,  1, 15,  9, 14 );
-    P2( A, B, C, D, E,  2, 14, 11, 12 );
-    P2( E, A, B, C, D,  7,  8,  8, 13 );
-    P2( D, E, A, B, C,  0, 13, 12,  5 );
-    P2( C, D, E, A, B,  6,  6,  2, 14 );
-    P2( B, C, D, E, A, 13,  5, 10, 13 );
-    P2( A, B, C, D, E, 11, 12,  0, 13 );
-    P2( E, A, B, C, D,  5,  7,  4,  7 );
-    P2( D, E, A, B, C, 12,  5, 13,  5 );
+        P2( D, E, A, B, C,  3, 11, 15,  9 );
+        P2( C, D, E, A, B, 10, 13,  5,  7 );
+        P2( B, C, D, E, A, 14,  6,  1, 15 );
+        P2( A, B, C, D, E,  4,  7,  3, 11 );
+        P2( E, A, B, C, D,  9, 14,  7,  8 );
+        P2( D, E, A, B, C, 15,  9, 14,  6 );
+        P2( C, D, E, A, B,  8, 13,  6,  6 );
+        P2( B, C, D, E, A,  1, 15,  9, 14 );
+        P2( A, B, C, D, E,  2, 14, 11, 12 );
+        P2( E, A, B, C, D,  7,  8,  8, 13 );
+        P2( D, E, A, B, C,  0, 13, 12,  5 );
+        P2( C, D, E, A, B,  6,  6,  2, 14 );
+        P2( B, C, D, E, A, 13,  5, 10, 13 );
+        P2( A, B, C, D, E, 11, 12,  0, 13 );
+        P2( E, A, B, C, D,  5,  7,  4,  7 );
+        P2( D, E, A, B, C, 12,  5, 13,  5 );
 #undef F
 #undef K
 #undef Fp
@@ -194,22 +196,22 @@ void myc_ripemd160_process( MYC_RIPEMD160_CTX *ctx, const uint8_t data[MYC_RIPEM
 #define K   0x8F1BBCDC
 #define Fp  F2
 #define Kp  0x7A6D76E9
-    P2( C, D, E, A, B,  1, 11,  8, 15 );
-    P2( B, C, D, E, A,  9, 12,  6,  5 );
-    P2( A, B, C, D, E, 11, 14,  4,  8 );
-    P2( E, A, B, C, D, 10, 15,  1, 11 );
-    P2( D, E, A, B, C,  0, 14,  3, 14 );
-    P2( C, D, E, A, B,  8, 15, 11, 14 );
-    P2( B, C, D, E, A, 12,  9, 15,  6 );
-    P2( A, B, C, D, E,  4,  8,  0, 14 );
-    P2( E, A, B, C, D, 13,  9,  5,  6 );
-    P2( D, E, A, B, C,  3, 14, 12,  9 );
-    P2( C, D, E, A, B,  7,  5,  2, 12 );
-    P2( B, C, D, E, A, 15,  6, 13,  9 );
-    P2( A, B, C, D, E, 14,  8,  9, 12 );
-    P2( E, A, B, C, D,  5,  6,  7,  5 );
-    P2( D, E, A, B, C,  6,  5, 10, 15 );
-    P2( C, D, E, A, B,  2, 12, 14,  8 );
+        P2( C, D, E, A, B,  1, 11,  8, 15 );
+        P2( B, C, D, E, A,  9, 12,  6,  5 );
+        P2( A, B, C, D, E, 11, 14,  4,  8 );
+        P2( E, A, B, C, D, 10, 15,  1, 11 );
+        P2( D, E, A, B, C,  0, 14,  3, 14 );
+        P2( C, D, E, A, B,  8, 15, 11, 14 );
+        P2( B, C, D, E, A, 12,  9, 15,  6 );
+        P2( A, B, C, D, E,  4,  8,  0, 14 );
+        P2( E, A, B, C, D, 13,  9,  5,  6 );
+        P2( D, E, A, B, C,  3, 14, 12,  9 );
+        P2( C, D, E, A, B,  7,  5,  2, 12 );
+        P2( B, C, D, E, A, 15,  6, 13,  9 );
+        P2( A, B, C, D, E, 14,  8,  9, 12 );
+        P2( E, A, B, C, D,  5,  6,  7,  5 );
+        P2( D, E, A, B, C,  6,  5, 10, 15 );
+        P2( C, D, E, A, B,  2, 12, 14,  8 );
 #undef F
 #undef K
 #undef Fp
@@ -219,35 +221,51 @@ void myc_ripemd160_process( MYC_RIPEMD160_CTX *ctx, const uint8_t data[MYC_RIPEM
 #define K   0xA953FD4E
 #define Fp  F1
 #define Kp  0x00000000
-    P2( B, C, D, E, A,  4,  9, 12,  8 );
-    P2( A, B, C, D, E,  0, 15, 15,  5 );
-    P2( E, A, B, C, D,  5,  5, 10, 12 );
-    P2( D, E, A, B, C,  9, 11,  4,  9 );
-    P2( C, D, E, A, B,  7,  6,  1, 12 );
-    P2( B, C, D, E, A, 12,  8,  5,  5 );
-    P2( A, B, C, D, E,  2, 13,  8, 14 );
-    P2( E, A, B, C, D, 10, 12,  7,  6 );
-    P2( D, E, A, B, C, 14,  5,  6,  8 );
-    P2( C, D, E, A, B,  1, 12,  2, 13 );
-    P2( B, C, D, E, A,  3, 13, 13,  6 );
-    P2( A, B, C, D, E,  8, 14, 14,  5 );
-    P2( E, A, B, C, D, 11, 11,  0, 15 );
-    P2( D, E, A, B, C,  6,  8,  3, 13 );
-    P2( C, D, E, A, B, 15,  5,  9, 11 );
-    P2( B, C, D, E, A, 13,  6, 11, 11 );
+        P2( B, C, D, E, A,  4,  9, 12,  8 );
+        P2( A, B, C, D, E,  0, 15, 15,  5 );
+        P2( E, A, B, C, D,  5,  5, 10, 12 );
+        P2( D, E, A, B, C,  9, 11,  4,  9 );
+        P2( C, D, E, A, B,  7,  6,  1, 12 );
+        P2( B, C, D, E, A, 12,  8,  5,  5 );
+        P2( A, B, C, D, E,  2, 13,  8, 14 );
+        P2( E, A, B, C, D, 10, 12,  7,  6 );
+        P2( D, E, A, B, C, 14,  5,  6,  8 );
+        P2( C, D, E, A, B,  1, 12,  2, 13 );
+        P2( B, C, D, E, A,  3, 13, 13,  6 );
+        P2( A, B, C, D, E,  8, 14, 14,  5 );
+        P2( E, A, B, C, D, 11, 11,  0, 15 );
+        P2( D, E, A, B, C,  6,  8,  3, 13 );
+        P2( C, D, E, A, B, 15,  5,  9, 11 );
+        P2( B, C, D, E, A, 13,  6, 11, 11 );
 #undef F
 #undef K
 #undef Fp
 #undef Kp
 
-    C             = ctx->state[1] + C + Dp;
-    ctx->state[1] = ctx->state[2] + D + Ep;
-    ctx->state[2] = ctx->state[3] + E + Ap;
-    ctx->state[3] = ctx->state[4] + A + Bp;
-    ctx->state[4] = ctx->state[0] + B + Cp;
-    ctx->state[0] = C;
+        C        = state[1] + C + Dp;
+        state[1] = state[2] + D + Ep;
+        state[2] = state[3] + E + Ap;
+        state[3] = state[4] + A + Bp;
+        state[4] = state[0] + B + Cp;
+        state[0] = C;
+    }
+}
+
+/*
+ * Process one block
+ */
+void myc_ripemd160_process( MYC_RIPEMD160_CTX *ctx, const uint8_t data[MYC_RIPEMD160_BLOCK_LENGTH] )
+{
+    myc_dispatch.ripemd160_process( ctx->state, data, 1 );
+}
+
+/*
+ * Process block_nb blocks with the 5-word chaining state
+ */
+void myc_ripemd160_transform( uint32_t *state, const uint8_t *blocks, size_t block_nb )
+{
+    myc_dispatch.ripemd160_process( state, blocks, block_nb );
 }
-#endif /* !MBEDTLS_RIPEMD160_PROCESS_ALT */
 
 /*
  * RIPEMD-160 process buffer
@@ -278,11 +296,13 @@ void myc_ripemd160_Update( MYC_RIPEMD160_CTX *ctx, const uint8_t *input, uint32_
         left = 0;
     }
 
-    while( ilen >= MYC_RIPEMD160_BLOCK_LENGTH )
+    if( ilen >= MYC_RIPEMD160_BLOCK_LENGTH )
     {
-        myc_ripemd160_process( ctx, input );
-        input += MYC_RIPEMD160_BLOCK_LENGTH;
-        ilen  -= MYC_RIPEMD160_BLOCK_LENGTH;
+        uint32_t block_nb = ilen / MYC_RIPEMD160_BLOCK_LENGTH;
+
+        myc_dispatch.ripemd160_process( ctx->state, input, block_nb );
+        input += block_nb * MYC_RIPEMD160_BLOCK_LENGTH;
+        ilen  -= block_nb * MYC_RIPEMD160_BLOCK_LENGTH;
     }
 
     if( ilen > 0 )
@@ -291,6 +311,28 @@ void myc_ripemd160_Update( MYC_RIPEMD160_CTX *ctx, const uint8_t *input, uint32_
     }
 }
 
+/*
+ * RIPEMD-160 process fragments, in parts of at most 1 GiB
+ */
+void myc_ripemd160_Updatev( MYC_RIPEMD160_CTX *ctx, const struct iovec *iov, int cnt )
+{
+    int i;
+
+    for( i = 0; i < cnt; i++ )
+    {
+        const uint8_t *input = (const uint8_t *) iov[i].iov_base;
+        size_t ilen = iov[i].iov_len;
+
+        while( ilen > 0x40000000 )
+        {
+            myc_ripemd160_Update( ctx, input, 0x40000000 );
+            input += 0x40000000;
+            ilen  -= 0x40000000;
+        }
+        myc_ripemd160_Update( ctx, input, (uint32_t) ilen );
+    }
+}
+
 static const uint8_t myc_ripemd160_padding[MYC_RIPEMD160_BLOCK_LENGTH] =
 {
  0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -331,6 +373,40 @@ void myc_ripemd160_Final( MYC_RIPEMD160_CTX *ctx, uint8_t output[MYC_RIPEMD160_D
     memset(ctx, 0, sizeof(MYC_RIPEMD160_CTX));
 }
 
+/*
+ * RIPEMD-160 digest of the input so far, ctx is left as it is: the
+ * padding goes to a local block, hashed with a copy of the state
+ */
+void myc_ripemd160_peek( const MYC_RIPEMD160_CTX *ctx, uint8_t output[MYC_RIPEMD160_DIGEST_LENGTH] )
+{
+    uint32_t state[5];
+    uint8_t block[2 * MYC_RIPEMD160_BLOCK_LENGTH];
+    uint32_t last, end;
+    uint32_t high, low;
+
+    high = ( ctx->total[0] >> 29 )
+         | ( ctx->total[1] <<  3 );
+    low  = ( ctx->total[0] <<  3 );
+
+    last = ctx->total[0] & 0x3F;
+    end = ( last < 56 ) ? 64 : 128;
+
+    memcpy( block, ctx->buffer, last );
+    memset( block + last, 0, end - last );
+    block[last] = 0x80;
+    PUT_UINT32_LE( low,  block, end - 8 );
+    PUT_UINT32_LE( high, block, end - 4 );
+
+    memcpy( state, ctx->state, sizeof( state ) );
+    myc_dispatch.ripemd160_process( state, block, end / 64 );
+
+    PUT_UINT32_LE( state[0], output,  0 );
+    PUT_UINT32_LE( state[1], output,  4 );
+    PUT_UINT32_LE( state[2], output,  8 );
+    PUT_UINT32_LE( state[3], output, 12 );
+    PUT_UINT32_LE( state[4], output, 16 );
+}
+
 /*
  * output = RIPEMD-160( input buffer )
  */
@@ -0,0 +1,119 @@
+/*
+ * RIPEMD-160 hashing of many independent messages
+ *
+ * Same scheme as the SHA-2 batch hashing: every lane runs over the
+ * full blocks of its message in place and then over its padded final
+ * blocks, and is refilled with the next message of the batch as soon
+ * as it is done.
+ */
+
+#include <string.h>
+
+#include "dispatch.h"
+#include "md_lane.h"
+
+#define RIPEMD160_MAX_LANES 16
+
+#define BLOCK_SIZE  MYC_RIPEMD160_BLOCK_LENGTH
+#define DIGEST_SIZE MYC_RIPEMD160_DIGEST_LENGTH
+
+static const uint32_t ripemd160_h0[5] = {
+    0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0
+};
+
+static void ripemd160_store(const uint32_t *state, unsigned int stride,
+                            uint8_t *digest)
+{
+    unsigned int i;
+
+    for (i = 0; i < 5; i++) {
+        uint32_t x = state[i * stride];
+
+        digest[i * 4 + 0] = (uint8_t) (x      );
+        digest[i * 4 + 1] = (uint8_t) (x >>  8);
+        digest[i * 4 + 2] = (uint8_t) (x >> 16);
+        digest[i * 4 + 3] = (uint8_t) (x >> 24);
+    }
+}
+
+static void ripemd160_batch_serial(const uint8_t **messages,
+                                   const size_t *lens, size_t count,
+                                   uint8_t *digests)
+{
+    md_lane lane;
+    uint32_t h[5];
+    size_t n;
+
+    for (n = 0; n < count; n++) {
+        memcpy(h, ripemd160_h0, sizeof(h));
+        md_lane_init(&lane, messages[n], lens[n], BLOCK_SIZE, 1);
+        do {
+            myc_dispatch.ripemd160_process(h, lane.data, lane.block_nb);
+        } while (md_lane_advance(&lane, lane.block_nb, BLOCK_SIZE));
+        ripemd160_store(h, 1, digests + n * DIGEST_SIZE);
+    }
+}
+
+void myc_ripemd160_batch(const uint8_t **messages, const size_t *lens,
+                         size_t count, uint8_t *digests)
+{
+    md_lane lanes[RIPEMD160_MAX_LANES];
+    const uint8_t *data[RIPEMD160_MAX_LANES];
+    ripemd160_mb_impl mb;
+    uint32_t state[5 * RIPEMD160_MAX_LANES];
+    size_t msg[RIPEMD160_MAX_LANES];
+    int active[RIPEMD160_MAX_LANES];
+    unsigned int lane_nb, left, l, i;
+    size_t next;
+
+    myc_dispatch_init();
+    mb = myc_dispatch.ripemd160_mb[MYC_BATCH_CLASS(count)];
+    lane_nb = mb.lanes;
+    if (mb.fn == NULL || lane_nb > RIPEMD160_MAX_LANES) {
+        ripemd160_batch_serial(messages, lens, count, digests);
+        return;
+    }
+
+    next = 0;
+    left = 0;
+    for (l = 0; l < lane_nb; l++) {
+        active[l] = next < count;
+        if (active[l]) {
+            msg[l] = next++;
+            md_lane_init(&lanes[l], messages[msg[l]], lens[msg[l]],
+                         BLOCK_SIZE, 1);
+            left++;
+        }
+        for (i = 0; i < 5; i++) {
+            state[i * lane_nb + l] = ripemd160_h0[i];
+        }
+    }
+
+    while (left > 0) {
+        size_t block_nb = md_lanes_next(lanes, active, lane_nb, data);
+
+        mb.fn(state, data, block_nb);
+
+        for (l = 0; l < lane_nb; l++) {
+            if (!active[l] || md_lane_advance(&lanes[l], block_nb,
+                                              BLOCK_SIZE))
+                continue;
+
+            ripemd160_store(&state[l], lane_nb,
+                            digests + msg[l] * DIGEST_SIZE);
+            if (next == count) {
+                active[l] = 0;
+                left--;
+                continue;
+            }
+
+            /* refill the lane with the next message */
+            msg[l] = next++;
+            md_lane_init(&lanes[l], messages[msg[l]], lens[msg[l]],
+                         BLOCK_SIZE, 1);
+            for (i = 0; i < 5; i++) {
+                state[i * lane_nb + l] = ripemd160_h0[i];
+            }
+        }
+    }
+}
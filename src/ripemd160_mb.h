@@ -0,0 +1,150 @@
+/*
+ * RIPEMD-160 steps shared by the multi-buffer transforms
+ *
+ * Every message stream has its own lane in a vector and the 80 steps of
+ * both lines run on whole vectors. The includer defines, for its
+ * vector type:
+ *
+ *   RMD_ADD(x, y)      32-bit lane addition
+ *   RMD_ROL(x, n)      rotation left by 0 < n < 32
+ *   RMD_SET1(k)        constant k in every lane
+ *   RMD_F1..RMD_F5     the five boolean functions of RIPEMD-160
+ *
+ * RIPEMD160_STEPS() then updates the left line A..E and the right line
+ * Ap..Ep from the message words in X[0..15]. Kernels keeping their
+ * lanes in scalar registers give their own step to RIPEMD160_MAP_STEPS().
+ */
+
+#ifndef MYC_RIPEMD160_MB_H
+#define MYC_RIPEMD160_MB_H
+
+/* Functions and constants of rounds 1..5, left and right lines */
+#define RMD_FL1 RMD_F1
+#define RMD_FL2 RMD_F2
+#define RMD_FL3 RMD_F3
+#define RMD_FL4 RMD_F4
+#define RMD_FL5 RMD_F5
+#define RMD_FR1 RMD_F5
+#define RMD_FR2 RMD_F4
+#define RMD_FR3 RMD_F3
+#define RMD_FR4 RMD_F2
+#define RMD_FR5 RMD_F1
+
+#define RMD_KL1 0x00000000
+#define RMD_KL2 0x5A827999
+#define RMD_KL3 0x6ED9EBA1
+#define RMD_KL4 0x8F1BBCDC
+#define RMD_KL5 0xA953FD4E
+#define RMD_KR1 0x50A28BE6
+#define RMD_KR2 0x5C4DD124
+#define RMD_KR3 0x6D703EF3
+#define RMD_KR4 0x7A6D76E9
+#define RMD_KR5 0x00000000
+
+#define RMD_STEP(a, b, c, d, e, r, s, f, k)                             \
+{                                                                       \
+    a = RMD_ADD(RMD_ROL(RMD_ADD(RMD_ADD(a, f(b, c, d)),                 \
+                                RMD_ADD(X[r], RMD_SET1(k))), s), e);    \
+    c = RMD_ROL(c, 10);                                                 \
+}
+
+/* Step of round j in both lines */
+#define RMD_STEP2(j, a, b, c, d, e, r, s, rp, sp)                       \
+{                                                                       \
+    RMD_STEP(a, b, c, d, e, r, s, RMD_FL##j, RMD_KL##j);                \
+    RMD_STEP(a##p, b##p, c##p, d##p, e##p, rp, sp,                      \
+             RMD_FR##j, RMD_KR##j);                                     \
+}
+
+/*
+ * OP(j, a, b, c, d, e, r, s, rp, sp) for the 80 steps, j being the
+ * round, r and s the message word and rotation of the left line, rp
+ * and sp those of the right line.
+ */
+#define RIPEMD160_MAP_STEPS(OP)                                         \
+{                                                                       \
+    OP(1, A, B, C, D, E,  0, 11,  5,  8);                               \
+    OP(1, E, A, B, C, D,  1, 14, 14,  9);                               \
+    OP(1, D, E, A, B, C,  2, 15,  7,  9);                               \
+    OP(1, C, D, E, A, B,  3, 12,  0, 11);                               \
+    OP(1, B, C, D, E, A,  4,  5,  9, 13);                               \
+    OP(1, A, B, C, D, E,  5,  8,  2, 15);                               \
+    OP(1, E, A, B, C, D,  6,  7, 11, 15);                               \
+    OP(1, D, E, A, B, C,  7,  9,  4,  5);                               \
+    OP(1, C, D, E, A, B,  8, 11, 13,  7);                               \
+    OP(1, B, C, D, E, A,  9, 13,  6,  7);                               \
+    OP(1, A, B, C, D, E, 10, 14, 15,  8);                               \
+    OP(1, E, A, B, C, D, 11, 15,  8, 11);                               \
+    OP(1, D, E, A, B, C, 12,  6,  1, 14);                               \
+    OP(1, C, D, E, A, B, 13,  7, 10, 14);                               \
+    OP(1, B, C, D, E, A, 14,  9,  3, 12);                               \
+    OP(1, A, B, C, D, E, 15,  8, 12,  6);                               \
+    OP(2, E, A, B, C, D,  7,  7,  6,  9);                               \
+    OP(2, D, E, A, B, C,  4,  6, 11, 13);                               \
+    OP(2, C, D, E, A, B, 13,  8,  3, 15);                               \
+    OP(2, B, C, D, E, A,  1, 13,  7,  7);                               \
+    OP(2, A, B, C, D, E, 10, 11,  0, 12);                               \
+    OP(2, E, A, B, C, D,  6,  9, 13,  8);                               \
+    OP(2, D, E, A, B, C, 15,  7,  5,  9);                               \
+    OP(2, C, D, E, A, B,  3, 15, 10, 11);                               \
+    OP(2, B, C, D, E, A, 12,  7, 14,  7);                               \
+    OP(2, A, B, C, D, E,  0, 12, 15,  7);                               \
+    OP(2, E, A, B, C, D,  9, 15,  8, 12);                               \
+    OP(2, D, E, A, B, C,  5,  9, 12,  7);                               \
+    OP(2, C, D, E, A, B,  2, 11,  4,  6);                               \
+    OP(2, B, C, D, E, A, 14,  7,  9, 15);                               \
+    OP(2, A, B, C, D, E, 11, 13,  1, 13);                               \
+    OP(2, E, A, B, C, D,  8, 12,  2, 11);                               \
+    OP(3, D, E, A, B, C,  3, 11, 15,  9);                               \
+    OP(3, C, D, E, A, B, 10, 13,  5,  7);                               \
+    OP(3, B, C, D, E, A, 14,  6,  1, 15);                               \
+    OP(3, A, B, C, D, E,  4,  7,  3, 11);                               \
+    OP(3, E, A, B, C, D,  9, 14,  7,  8);                               \
+    OP(3, D, E, A, B, C, 15,  9, 14,  6);                               \
+    OP(3, C, D, E, A, B,  8, 13,  6,  6);                               \
+    OP(3, B, C, D, E, A,  1, 15,  9, 14);                               \
+    OP(3, A, B, C, D, E,  2, 14, 11, 12);                               \
+    OP(3, E, A, B, C, D,  7,  8,  8, 13);                               \
+    OP(3, D, E, A, B, C,  0, 13, 12,  5);                               \
+    OP(3, C, D, E, A, B,  6,  6,  2, 14);                               \
+    OP(3, B, C, D, E, A, 13,  5, 10, 13);                               \
+    OP(3, A, B, C, D, E, 11, 12,  0, 13);                               \
+    OP(3, E, A, B, C, D,  5,  7,  4,  7);                               \
+    OP(3, D, E, A, B, C, 12,  5, 13,  5);                               \
+    OP(4, C, D, E, A, B,  1, 11,  8, 15);                               \
+    OP(4, B, C, D, E, A,  9, 12,  6,  5);                               \
+    OP(4, A, B, C, D, E, 11, 14,  4,  8);                               \
+    OP(4, E, A, B, C, D, 10, 15,  1, 11);                               \
+    OP(4, D, E, A, B, C,  0, 14,  3, 14);                               \
+    OP(4, C, D, E, A, B,  8, 15, 11, 14);                               \
+    OP(4, B, C, D, E, A, 12,  9, 15,  6);                               \
+    OP(4, A, B, C, D, E,  4,  8,  0, 14);                               \
+    OP(4, E, A, B, C, D, 13,  9,  5,  6);                               \
+    OP(4, D, E, A, B, C,  3, 14, 12,  9);                               \
+    OP(4, C, D, E, A, B,  7,  5,  2, 12);                               \
+    OP(4, B, C, D, E, A, 15,  6, 13,  9);                               \
+    OP(4, A, B, C, D, E, 14,  8,  9, 12);                               \
+    OP(4, E, A, B, C, D,  5,  6,  7,  5);                               \
+    OP(4, D, E, A, B, C,  6,  5, 10, 15);                               \
+    OP(4, C, D, E, A, B,  2, 12, 14,  8);                               \
+    OP(5, B, C, D, E, A,  4,  9, 12,  8);                               \
+    OP(5, A, B, C, D, E,  0, 15, 15,  5);                               \
+    OP(5, E, A, B, C, D,  5,  5, 10, 12);                               \
+    OP(5, D, E, A, B, C,  9, 11,  4,  9);                               \
+    OP(5, C, D, E, A, B,  7,  6,  1, 12);                               \
+    OP(5, B, C, D, E, A, 12,  8,  5,  5);                               \
+    OP(5, A, B, C, D, E,  2, 13,  8, 14);                               \
+    OP(5, E, A, B, C, D, 10, 12,  7,  6);                               \
+    OP(5, D, E, A, B, C, 14,  5,  6,  8);                               \
+    OP(5, C, D, E, A, B,  1, 12,  2, 13);                               \
+    OP(5, B, C, D, E, A,  3, 13, 13,  6);                               \
+    OP(5, A, B, C, D, E,  8, 14, 14,  5);                               \
+    OP(5, E, A, B, C, D, 11, 11,  0, 15);                               \
+    OP(5, D, E, A, B, C,  6,  8,  3, 13);                               \
+    OP(5, C, D, E, A, B, 15,  5,  9, 11);                               \
+    OP(5, B, C, D, E, A, 13,  6, 11, 11);                               \
+}
+
+#define RIPEMD160_STEPS() RIPEMD160_MAP_STEPS(RMD_STEP2)
+
+#endif /* !MYC_RIPEMD160_MB_H */
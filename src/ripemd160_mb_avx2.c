@@ -0,0 +1,124 @@
+/*
+ * 8-lane multi-buffer RIPEMD-160 block transform (AVX2)
+ *
+ * Same layout as the SSE2 transform with one stream per 32-bit lane of
+ * a ymm register: state[i * 8 + l] is word i of lane l.
+ */
+
+#include "dispatch.h"
+
+#ifdef MYC_X86
+
+#include <immintrin.h>
+
+#include "ripemd160_mb.h"
+
+#define MB_TARGET __attribute__((target("avx2")))
+
+#define RMD_ADD(x, y)  _mm256_add_epi32(x, y)
+#define RMD_ROL(x, n)  _mm256_or_si256(_mm256_slli_epi32(x, n),          \
+                                       _mm256_srli_epi32(x, 32 - (n)))
+#define RMD_SET1(k)    _mm256_set1_epi32((int) (k))
+
+#define NOT(x) _mm256_xor_si256(x, ones)
+
+#define RMD_F1(x, y, z) _mm256_xor_si256(_mm256_xor_si256(x, y), z)
+#define RMD_F2(x, y, z) _mm256_or_si256(_mm256_and_si256(x, y),          \
+                                        _mm256_andnot_si256(x, z))
+#define RMD_F3(x, y, z) _mm256_xor_si256(_mm256_or_si256(x, NOT(y)), z)
+#define RMD_F4(x, y, z) _mm256_or_si256(_mm256_and_si256(x, z),          \
+                                        _mm256_andnot_si256(z, y))
+#define RMD_F5(x, y, z) _mm256_xor_si256(x, _mm256_or_si256(y, NOT(z)))
+
+/* Load 8 little-endian words from each lane, transposed to word-major */
+MB_TARGET
+static void load_words(__m256i *out, const uint8_t *const *data,
+                       size_t offset)
+{
+    __m256i r0, r1, r2, r3, r4, r5, r6, r7;
+    __m256i t0, t1, t2, t3, t4, t5, t6, t7;
+
+    r0 = _mm256_loadu_si256((const __m256i *) (data[0] + offset));
+    r1 = _mm256_loadu_si256((const __m256i *) (data[1] + offset));
+    r2 = _mm256_loadu_si256((const __m256i *) (data[2] + offset));
+    r3 = _mm256_loadu_si256((const __m256i *) (data[3] + offset));
+    r4 = _mm256_loadu_si256((const __m256i *) (data[4] + offset));
+    r5 = _mm256_loadu_si256((const __m256i *) (data[5] + offset));
+    r6 = _mm256_loadu_si256((const __m256i *) (data[6] + offset));
+    r7 = _mm256_loadu_si256((const __m256i *) (data[7] + offset));
+
+    t0 = _mm256_unpacklo_epi32(r0, r1);
+    t1 = _mm256_unpackhi_epi32(r0, r1);
+    t2 = _mm256_unpacklo_epi32(r2, r3);
+    t3 = _mm256_unpackhi_epi32(r2, r3);
+    t4 = _mm256_unpacklo_epi32(r4, r5);
+    t5 = _mm256_unpackhi_epi32(r4, r5);
+    t6 = _mm256_unpacklo_epi32(r6, r7);
+    t7 = _mm256_unpackhi_epi32(r6, r7);
+
+    r0 = _mm256_unpacklo_epi64(t0, t2);
+    r1 = _mm256_unpackhi_epi64(t0, t2);
+    r2 = _mm256_unpacklo_epi64(t1, t3);
+    r3 = _mm256_unpackhi_epi64(t1, t3);
+    r4 = _mm256_unpacklo_epi64(t4, t6);
+    r5 = _mm256_unpackhi_epi64(t4, t6);
+    r6 = _mm256_unpacklo_epi64(t5, t7);
+    r7 = _mm256_unpackhi_epi64(t5, t7);
+
+    out[0] = _mm256_permute2x128_si256(r0, r4, 0x20);
+    out[1] = _mm256_permute2x128_si256(r1, r5, 0x20);
+    out[2] = _mm256_permute2x128_si256(r2, r6, 0x20);
+    out[3] = _mm256_permute2x128_si256(r3, r7, 0x20);
+    out[4] = _mm256_permute2x128_si256(r0, r4, 0x31);
+    out[5] = _mm256_permute2x128_si256(r1, r5, 0x31);
+    out[6] = _mm256_permute2x128_si256(r2, r6, 0x31);
+    out[7] = _mm256_permute2x128_si256(r3, r7, 0x31);
+}
+
+MB_TARGET
+void myc_ripemd160_process_x8_avx2(uint32_t *state,
+                                   const uint8_t *const *data,
+                                   size_t block_nb)
+{
+    const __m256i ones = _mm256_set1_epi32(-1);
+    __m256i A, B, C, D, E, Ap, Bp, Cp, Dp, Ep;
+    __m256i h0, h1, h2, h3, h4;
+    __m256i X[16];
+    size_t i;
+
+    h0 = _mm256_loadu_si256((const __m256i *) &state[0 * 8]);
+    h1 = _mm256_loadu_si256((const __m256i *) &state[1 * 8]);
+    h2 = _mm256_loadu_si256((const __m256i *) &state[2 * 8]);
+    h3 = _mm256_loadu_si256((const __m256i *) &state[3 * 8]);
+    h4 = _mm256_loadu_si256((const __m256i *) &state[4 * 8]);
+
+    for (i = 0; i < block_nb; i++) {
+        size_t offset = i * MYC_RIPEMD160_BLOCK_LENGTH;
+
+        load_words(&X[0], data, offset);
+        load_words(&X[8], data, offset + 32);
+
+        A = Ap = h0;
+        B = Bp = h1;
+        C = Cp = h2;
+        D = Dp = h3;
+        E = Ep = h4;
+
+        RIPEMD160_STEPS();
+
+        C  = RMD_ADD(RMD_ADD(h1, C), Dp);
+        h1 = RMD_ADD(RMD_ADD(h2, D), Ep);
+        h2 = RMD_ADD(RMD_ADD(h3, E), Ap);
+        h3 = RMD_ADD(RMD_ADD(h4, A), Bp);
+        h4 = RMD_ADD(RMD_ADD(h0, B), Cp);
+        h0 = C;
+    }
+
+    _mm256_storeu_si256((__m256i *) &state[0 * 8], h0);
+    _mm256_storeu_si256((__m256i *) &state[1 * 8], h1);
+    _mm256_storeu_si256((__m256i *) &state[2 * 8], h2);
+    _mm256_storeu_si256((__m256i *) &state[3 * 8], h3);
+    _mm256_storeu_si256((__m256i *) &state[4 * 8], h4);
+}
+
+#endif /* MYC_X86 */
@@ -0,0 +1,135 @@
+/*
+ * 16-lane multi-buffer RIPEMD-160 block transform (AVX-512)
+ *
+ * Same layout as the AVX2 transform with one stream per 32-bit lane of
+ * a zmm register. Rotations use vprold and each of the five boolean
+ * functions is a single vpternlogd.
+ */
+
+#include "dispatch.h"
+
+#ifdef MYC_X86
+
+#include <immintrin.h>
+
+#include "ripemd160_mb.h"
+
+#define MB_TARGET __attribute__((target("avx512f")))
+
+#define RMD_ADD(x, y)  _mm512_add_epi32(x, y)
+#define RMD_ROL(x, n)  _mm512_rol_epi32(x, n)
+#define RMD_SET1(k)    _mm512_set1_epi32((int) (k))
+
+#define RMD_F1(x, y, z) _mm512_ternarylogic_epi32(x, y, z, 0x96)
+#define RMD_F2(x, y, z) _mm512_ternarylogic_epi32(x, y, z, 0xCA)
+#define RMD_F3(x, y, z) _mm512_ternarylogic_epi32(x, y, z, 0x59)
+#define RMD_F4(x, y, z) _mm512_ternarylogic_epi32(x, y, z, 0xE4)
+#define RMD_F5(x, y, z) _mm512_ternarylogic_epi32(x, y, z, 0x2D)
+
+/* Transpose 8 words of 8 lanes, out[i] holds word i of every lane */
+MB_TARGET
+static void transpose8(__m256i *out, const uint8_t *const *data,
+                       size_t offset)
+{
+    __m256i r0, r1, r2, r3, r4, r5, r6, r7;
+    __m256i t0, t1, t2, t3, t4, t5, t6, t7;
+
+    r0 = _mm256_loadu_si256((const __m256i *) (data[0] + offset));
+    r1 = _mm256_loadu_si256((const __m256i *) (data[1] + offset));
+    r2 = _mm256_loadu_si256((const __m256i *) (data[2] + offset));
+    r3 = _mm256_loadu_si256((const __m256i *) (data[3] + offset));
+    r4 = _mm256_loadu_si256((const __m256i *) (data[4] + offset));
+    r5 = _mm256_loadu_si256((const __m256i *) (data[5] + offset));
+    r6 = _mm256_loadu_si256((const __m256i *) (data[6] + offset));
+    r7 = _mm256_loadu_si256((const __m256i *) (data[7] + offset));
+
+    t0 = _mm256_unpacklo_epi32(r0, r1);
+    t1 = _mm256_unpackhi_epi32(r0, r1);
+    t2 = _mm256_unpacklo_epi32(r2, r3);
+    t3 = _mm256_unpackhi_epi32(r2, r3);
+    t4 = _mm256_unpacklo_epi32(r4, r5);
+    t5 = _mm256_unpackhi_epi32(r4, r5);
+    t6 = _mm256_unpacklo_epi32(r6, r7);
+    t7 = _mm256_unpackhi_epi32(r6, r7);
+
+    r0 = _mm256_unpacklo_epi64(t0, t2);
+    r1 = _mm256_unpackhi_epi64(t0, t2);
+    r2 = _mm256_unpacklo_epi64(t1, t3);
+    r3 = _mm256_unpackhi_epi64(t1, t3);
+    r4 = _mm256_unpacklo_epi64(t4, t6);
+    r5 = _mm256_unpackhi_epi64(t4, t6);
+    r6 = _mm256_unpacklo_epi64(t5, t7);
+    r7 = _mm256_unpackhi_epi64(t5, t7);
+
+    out[0] = _mm256_permute2x128_si256(r0, r4, 0x20);
+    out[1] = _mm256_permute2x128_si256(r1, r5, 0x20);
+    out[2] = _mm256_permute2x128_si256(r2, r6, 0x20);
+    out[3] = _mm256_permute2x128_si256(r3, r7, 0x20);
+    out[4] = _mm256_permute2x128_si256(r0, r4, 0x31);
+    out[5] = _mm256_permute2x128_si256(r1, r5, 0x31);
+    out[6] = _mm256_permute2x128_si256(r2, r6, 0x31);
+    out[7] = _mm256_permute2x128_si256(r3, r7, 0x31);
+}
+
+/* Load 8 little-endian words from each of the 16 lanes, word-major */
+MB_TARGET
+static void load_words(__m512i *out, const uint8_t *const *data,
+                       size_t offset)
+{
+    __m256i lo[8], hi[8];
+    int i;
+
+    transpose8(lo, data, offset);
+    transpose8(hi, data + 8, offset);
+
+    for (i = 0; i < 8; i++) {
+        out[i] = _mm512_inserti64x4(_mm512_castsi256_si512(lo[i]), hi[i], 1);
+    }
+}
+
+MB_TARGET
+void myc_ripemd160_process_x16_avx512(uint32_t *state,
+                                      const uint8_t *const *data,
+                                      size_t block_nb)
+{
+    __m512i A, B, C, D, E, Ap, Bp, Cp, Dp, Ep;
+    __m512i h0, h1, h2, h3, h4;
+    __m512i X[16];
+    size_t i;
+
+    h0 = _mm512_loadu_si512(&state[0 * 16]);
+    h1 = _mm512_loadu_si512(&state[1 * 16]);
+    h2 = _mm512_loadu_si512(&state[2 * 16]);
+    h3 = _mm512_loadu_si512(&state[3 * 16]);
+    h4 = _mm512_loadu_si512(&state[4 * 16]);
+
+    for (i = 0; i < block_nb; i++) {
+        size_t offset = i * MYC_RIPEMD160_BLOCK_LENGTH;
+
+        load_words(&X[0], data, offset);
+        load_words(&X[8], data, offset + 32);
+
+        A = Ap = h0;
+        B = Bp = h1;
+        C = Cp = h2;
+        D = Dp = h3;
+        E = Ep = h4;
+
+        RIPEMD160_STEPS();
+
+        C  = RMD_ADD(RMD_ADD(h1, C), Dp);
+        h1 = RMD_ADD(RMD_ADD(h2, D), Ep);
+        h2 = RMD_ADD(RMD_ADD(h3, E), Ap);
+        h3 = RMD_ADD(RMD_ADD(h4, A), Bp);
+        h4 = RMD_ADD(RMD_ADD(h0, B), Cp);
+        h0 = C;
+    }
+
+    _mm512_storeu_si512(&state[0 * 16], h0);
+    _mm512_storeu_si512(&state[1 * 16], h1);
+    _mm512_storeu_si512(&state[2 * 16], h2);
+    _mm512_storeu_si512(&state[3 * 16], h3);
+    _mm512_storeu_si512(&state[4 * 16], h4);
+}
+
+#endif /* MYC_X86 */
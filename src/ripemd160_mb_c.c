@@ -0,0 +1,85 @@
+/*
+ * 2-lane RIPEMD-160 block transform (portable)
+ *
+ * Two independent message streams are hashed in general purpose
+ * registers, the steps of both being interleaved so that a superscalar
+ * core runs four dependency chains, two lines of two streams, instead
+ * of two. This is the multi-buffer engine of CPUs without SIMD units.
+ * The state is word-major as for the SIMD transforms: state[i * 2 + l]
+ * is word i of lane l.
+ */
+
+#include "dispatch.h"
+#include "ripemd160_mb.h"
+
+#define ROL(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+#define RMD_F1(x, y, z) ((x) ^ (y) ^ (z))
+#define RMD_F2(x, y, z) (((x) & (y)) | (~(x) & (z)))
+#define RMD_F3(x, y, z) (((x) | ~(y)) ^ (z))
+#define RMD_F4(x, y, z) (((x) & (z)) | ((y) & ~(z)))
+#define RMD_F5(x, y, z) ((x) ^ ((y) | ~(z)))
+
+#define STEP(a, b, c, d, e, x, s, f, k)                                 \
+{                                                                       \
+    a = ROL(a + f(b, c, d) + (x) + (k), s) + e;                         \
+    c = ROL(c, 10);                                                     \
+}
+
+/* Step of round j in both lines of both lanes */
+#define STEP_X2(j, a, b, c, d, e, r, s, rp, sp)                         \
+{                                                                       \
+    STEP(a##0, b##0, c##0, d##0, e##0, X0[r], s, RMD_FL##j, RMD_KL##j); \
+    STEP(a##1, b##1, c##1, d##1, e##1, X1[r], s, RMD_FL##j, RMD_KL##j); \
+    STEP(a##p0, b##p0, c##p0, d##p0, e##p0, X0[rp], sp,                 \
+         RMD_FR##j, RMD_KR##j);                                         \
+    STEP(a##p1, b##p1, c##p1, d##p1, e##p1, X1[rp], sp,                 \
+         RMD_FR##j, RMD_KR##j);                                         \
+}
+
+#define GET_UINT32_LE(b, i)                                             \
+    (  (uint32_t) (b)[(i)    ]        | ((uint32_t) (b)[(i) + 1] <<  8) \
+     | ((uint32_t) (b)[(i) + 2] << 16) | ((uint32_t) (b)[(i) + 3] << 24))
+
+/* Chaining state of lane l updated from the two lines */
+#define FEED_FORWARD(l)                                                 \
+{                                                                       \
+    uint32_t t = state[1 * 2 + l] + C##l + Dp##l;                       \
+                                                                        \
+    state[1 * 2 + l] = state[2 * 2 + l] + D##l + Ep##l;                 \
+    state[2 * 2 + l] = state[3 * 2 + l] + E##l + Ap##l;                 \
+    state[3 * 2 + l] = state[4 * 2 + l] + A##l + Bp##l;                 \
+    state[4 * 2 + l] = state[0 * 2 + l] + B##l + Cp##l;                 \
+    state[0 * 2 + l] = t;                                               \
+}
+
+void myc_ripemd160_process_x2_c(uint32_t *state, const uint8_t *const *data,
+                                size_t block_nb)
+{
+    uint32_t A0, B0, C0, D0, E0, Ap0, Bp0, Cp0, Dp0, Ep0;
+    uint32_t A1, B1, C1, D1, E1, Ap1, Bp1, Cp1, Dp1, Ep1;
+    uint32_t X0[16], X1[16];
+    size_t i;
+    int j;
+
+    for (i = 0; i < block_nb; i++) {
+        const uint8_t *p0 = data[0] + i * MYC_RIPEMD160_BLOCK_LENGTH;
+        const uint8_t *p1 = data[1] + i * MYC_RIPEMD160_BLOCK_LENGTH;
+
+        for (j = 0; j < 16; j++) {
+            X0[j] = GET_UINT32_LE(p0, j * 4);
+            X1[j] = GET_UINT32_LE(p1, j * 4);
+        }
+
+        A0 = Ap0 = state[0 * 2 + 0]; A1 = Ap1 = state[0 * 2 + 1];
+        B0 = Bp0 = state[1 * 2 + 0]; B1 = Bp1 = state[1 * 2 + 1];
+        C0 = Cp0 = state[2 * 2 + 0]; C1 = Cp1 = state[2 * 2 + 1];
+        D0 = Dp0 = state[3 * 2 + 0]; D1 = Dp1 = state[3 * 2 + 1];
+        E0 = Ep0 = state[4 * 2 + 0]; E1 = Ep1 = state[4 * 2 + 1];
+
+        RIPEMD160_MAP_STEPS(STEP_X2);
+
+        FEED_FORWARD(0);
+        FEED_FORWARD(1);
+    }
+}
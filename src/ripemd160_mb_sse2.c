@@ -0,0 +1,106 @@
+/*
+ * 4-lane multi-buffer RIPEMD-160 block transform (SSE2)
+ *
+ * Each 32-bit lane of an xmm register carries one independent message
+ * stream and both lines of the compression function run on whole
+ * registers. The chaining state is stored word-major: state[i * 4 + l]
+ * is word i of lane l.
+ */
+
+#include "dispatch.h"
+
+#ifdef MYC_X86
+
+#include <immintrin.h>
+
+#include "ripemd160_mb.h"
+
+#define MB_TARGET __attribute__((target("sse2")))
+
+#define RMD_ADD(x, y)  _mm_add_epi32(x, y)
+#define RMD_ROL(x, n)  _mm_or_si128(_mm_slli_epi32(x, n),                \
+                                    _mm_srli_epi32(x, 32 - (n)))
+#define RMD_SET1(k)    _mm_set1_epi32((int) (k))
+
+#define NOT(x) _mm_xor_si128(x, ones)
+
+#define RMD_F1(x, y, z) _mm_xor_si128(_mm_xor_si128(x, y), z)
+#define RMD_F2(x, y, z) _mm_or_si128(_mm_and_si128(x, y),                \
+                                     _mm_andnot_si128(x, z))
+#define RMD_F3(x, y, z) _mm_xor_si128(_mm_or_si128(x, NOT(y)), z)
+#define RMD_F4(x, y, z) _mm_or_si128(_mm_and_si128(x, z),                \
+                                     _mm_andnot_si128(z, y))
+#define RMD_F5(x, y, z) _mm_xor_si128(x, _mm_or_si128(y, NOT(z)))
+
+/* Load 4 little-endian words from each lane, transposed to word-major */
+MB_TARGET
+static void load_words(__m128i *out, const uint8_t *const *data,
+                       size_t offset)
+{
+    __m128i r0, r1, r2, r3, t0, t1, t2, t3;
+
+    r0 = _mm_loadu_si128((const __m128i *) (data[0] + offset));
+    r1 = _mm_loadu_si128((const __m128i *) (data[1] + offset));
+    r2 = _mm_loadu_si128((const __m128i *) (data[2] + offset));
+    r3 = _mm_loadu_si128((const __m128i *) (data[3] + offset));
+
+    t0 = _mm_unpacklo_epi32(r0, r1);
+    t1 = _mm_unpackhi_epi32(r0, r1);
+    t2 = _mm_unpacklo_epi32(r2, r3);
+    t3 = _mm_unpackhi_epi32(r2, r3);
+
+    out[0] = _mm_unpacklo_epi64(t0, t2);
+    out[1] = _mm_unpackhi_epi64(t0, t2);
+    out[2] = _mm_unpacklo_epi64(t1, t3);
+    out[3] = _mm_unpackhi_epi64(t1, t3);
+}
+
+MB_TARGET
+void myc_ripemd160_process_x4_sse2(uint32_t *state,
+                                   const uint8_t *const *data,
+                                   size_t block_nb)
+{
+    const __m128i ones = _mm_set1_epi32(-1);
+    __m128i A, B, C, D, E, Ap, Bp, Cp, Dp, Ep;
+    __m128i h0, h1, h2, h3, h4;
+    __m128i X[16];
+    size_t i;
+
+    h0 = _mm_loadu_si128((const __m128i *) &state[0 * 4]);
+    h1 = _mm_loadu_si128((const __m128i *) &state[1 * 4]);
+    h2 = _mm_loadu_si128((const __m128i *) &state[2 * 4]);
+    h3 = _mm_loadu_si128((const __m128i *) &state[3 * 4]);
+    h4 = _mm_loadu_si128((const __m128i *) &state[4 * 4]);
+
+    for (i = 0; i < block_nb; i++) {
+        size_t offset = i * MYC_RIPEMD160_BLOCK_LENGTH;
+
+        load_words(&X[ 0], data, offset);
+        load_words(&X[ 4], data, offset + 16);
+        load_words(&X[ 8], data, offset + 32);
+        load_words(&X[12], data, offset + 48);
+
+        A = Ap = h0;
+        B = Bp = h1;
+        C = Cp = h2;
+        D = Dp = h3;
+        E = Ep = h4;
+
+        RIPEMD160_STEPS();
+
+        C  = RMD_ADD(RMD_ADD(h1, C), Dp);
+        h1 = RMD_ADD(RMD_ADD(h2, D), Ep);
+        h2 = RMD_ADD(RMD_ADD(h3, E), Ap);
+        h3 = RMD_ADD(RMD_ADD(h4, A), Bp);
+        h4 = RMD_ADD(RMD_ADD(h0, B), Cp);
+        h0 = C;
+    }
+
+    _mm_storeu_si128((__m128i *) &state[0 * 4], h0);
+    _mm_storeu_si128((__m128i *) &state[1 * 4], h1);
+    _mm_storeu_si128((__m128i *) &state[2 * 4], h2);
+    _mm_storeu_si128((__m128i *) &state[3 * 4], h3);
+    _mm_storeu_si128((__m128i *) &state[4 * 4], h4);
+}
+
+#endif /* MYC_X86 */
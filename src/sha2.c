@@ -35,9 +35,14 @@
 #define UNROLL_LOOPS /* Enable loops unrolling */
 #endif
 
+#include <stdlib.h>
 #include <string.h>
+#include <sys/uio.h>
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
 
-#include "sha2.h"
+#include "dispatch.h"
 
 #define SHFR(x, n)    (x >> n)
 #define ROTR(x, n)   ((x >> n) | (x << ((sizeof(x) << 3) - n)))
@@ -95,36 +100,75 @@
            | ((uint64) *((str) + 0) << 56);   \
 }
 
-/* Macros used for loops unrolling */
-
-#define SHA256_SCR(i)                         \
+/* SHA-384/512 count the message bytes on 128 bits, low word first */
+#define SHA512_ADD_LEN(ctx, n)                \
 {                                             \
-    w[i] =  SHA256_F4(w[i -  2]) + w[i -  7]  \
-          + SHA256_F3(w[i - 15]) + w[i - 16]; \
+    (ctx)->tot_len[0] += (n);                 \
+    if ((ctx)->tot_len[0] < (n))              \
+        (ctx)->tot_len[1]++;                  \
 }
 
-#define SHA512_SCR(i)                         \
-{                                             \
-    w[i] =  SHA512_F4(w[i -  2]) + w[i -  7]  \
-          + SHA512_F3(w[i - 15]) + w[i - 16]; \
+/*
+ * Rounds of the portable transforms. The message schedule is a
+ * circular buffer of 16 words, word j + t being loaded or computed
+ * just before round j + t, and the working variables are renamed from
+ * one round to the next instead of being moved.
+ */
+
+#define SHA256_LOAD(t) PACK32(&sub_block[(t) << 2], &w[t])
+#define SHA512_LOAD(t) PACK64(&sub_block[(t) << 3], &w[t])
+
+#define SHA256_SCR(t)                                       \
+{                                                           \
+    w[t] +=  SHA256_F4(w[((t) + 14) & 15]) + w[((t) + 9) & 15] \
+           + SHA256_F3(w[((t) +  1) & 15]);                 \
 }
 
-#define SHA256_EXP(a, b, c, d, e, f, g, h, j)               \
+#define SHA512_SCR(t)                                       \
 {                                                           \
-    t1 = wv[h] + SHA256_F2(wv[e]) + CH(wv[e], wv[f], wv[g]) \
-         + sha256_k[j] + w[j];                              \
-    t2 = SHA256_F1(wv[a]) + MAJ(wv[a], wv[b], wv[c]);       \
-    wv[d] += t1;                                            \
-    wv[h] = t1 + t2;                                        \
+    w[t] +=  SHA512_F4(w[((t) + 14) & 15]) + w[((t) + 9) & 15] \
+           + SHA512_F3(w[((t) +  1) & 15]);                 \
 }
 
-#define SHA512_EXP(a, b, c, d, e, f, g ,h, j)               \
+#define SHA256_EXP(a, b, c, d, e, f, g, h, t, SCHED)        \
 {                                                           \
-    t1 = wv[h] + SHA512_F2(wv[e]) + CH(wv[e], wv[f], wv[g]) \
-         + sha512_k[j] + w[j];                              \
-    t2 = SHA512_F1(wv[a]) + MAJ(wv[a], wv[b], wv[c]);       \
-    wv[d] += t1;                                            \
-    wv[h] = t1 + t2;                                        \
+    SCHED(t);                                               \
+    t1 = h + SHA256_F2(e) + CH(e, f, g) + sha256_k[j + (t)] \
+         + w[t];                                            \
+    t2 = SHA256_F1(a) + MAJ(a, b, c);                       \
+    d += t1;                                                \
+    h = t1 + t2;                                            \
+}
+
+#define SHA512_EXP(a, b, c, d, e, f, g, h, t, SCHED)        \
+{                                                           \
+    SCHED(t);                                               \
+    t1 = h + SHA512_F2(e) + CH(e, f, g) + sha512_k[j + (t)] \
+         + w[t];                                            \
+    t2 = SHA512_F1(a) + MAJ(a, b, c);                       \
+    d += t1;                                                \
+    h = t1 + t2;                                            \
+}
+
+/* Rounds j..j+15, after which every variable is back in place */
+#define SHA2_ROUNDS16(EXP, SCHED)                           \
+{                                                           \
+    EXP(a, b, c, d, e, f, g, hh,  0, SCHED);                \
+    EXP(hh, a, b, c, d, e, f, g,  1, SCHED);                \
+    EXP(g, hh, a, b, c, d, e, f,  2, SCHED);                \
+    EXP(f, g, hh, a, b, c, d, e,  3, SCHED);                \
+    EXP(e, f, g, hh, a, b, c, d,  4, SCHED);                \
+    EXP(d, e, f, g, hh, a, b, c,  5, SCHED);                \
+    EXP(c, d, e, f, g, hh, a, b,  6, SCHED);                \
+    EXP(b, c, d, e, f, g, hh, a,  7, SCHED);                \
+    EXP(a, b, c, d, e, f, g, hh,  8, SCHED);                \
+    EXP(hh, a, b, c, d, e, f, g,  9, SCHED);                \
+    EXP(g, hh, a, b, c, d, e, f, 10, SCHED);                \
+    EXP(f, g, hh, a, b, c, d, e, 11, SCHED);                \
+    EXP(e, f, g, hh, a, b, c, d, 12, SCHED);                \
+    EXP(d, e, f, g, hh, a, b, c, 13, SCHED);                \
+    EXP(c, d, e, f, g, hh, a, b, 14, SCHED);                \
+    EXP(b, c, d, e, f, g, hh, a, 15, SCHED);                \
 }
 
 uint32 sha224_h0[8] =
@@ -207,124 +251,80 @@ uint64 sha512_k[80] =
              0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL,
              0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL};
 
+/* The sizes announced in sha2.h, checked at compile time */
+typedef char sha256_ctx_size_check[
+    sizeof(myc_sha256_ctx) == MYC_SHA256_CTX_SIZE ? 1 : -1];
+typedef char sha512_ctx_size_check[
+    sizeof(myc_sha512_ctx) == MYC_SHA512_CTX_SIZE ? 1 : -1];
+
+unsigned int myc_sha2_ctx_version(void)
+{
+    return MYC_SHA2_CTX_VERSION;
+}
+
+void *myc_sha2_ctx_alloc(size_t size)
+{
+#if defined(_WIN32)
+    return _aligned_malloc(size, MYC_SHA2_CTX_ALIGNMENT);
+#else
+    void *ctx;
+
+    if (posix_memalign(&ctx, MYC_SHA2_CTX_ALIGNMENT, size) != 0)
+        return NULL;
+    return ctx;
+#endif
+}
+
+void myc_sha2_ctx_free(void *ctx)
+{
+#if defined(_WIN32)
+    _aligned_free(ctx);
+#else
+    free(ctx);
+#endif
+}
+
 /* SHA-256 functions */
 
-void sha256_transf(myc_sha256_ctx *ctx, const unsigned char *message,
-                   unsigned int block_nb)
+void sha256_transf_c(uint32 *h, const unsigned char *message, size_t block_nb)
 {
-    uint32 w[64];
-    uint32 wv[8];
+    uint32 w[16];
+    uint32 a, b, c, d, e, f, g, hh;
     uint32 t1, t2;
     const unsigned char *sub_block;
-    int i;
-
-#ifndef UNROLL_LOOPS
+    size_t i;
     int j;
-#endif
 
-    for (i = 0; i < (int) block_nb; i++) {
+    for (i = 0; i < block_nb; i++) {
         sub_block = message + (i << 6);
 
-#ifndef UNROLL_LOOPS
-        for (j = 0; j < 16; j++) {
-            PACK32(&sub_block[j << 2], &w[j]);
-        }
+        a = h[0]; b = h[1]; c = h[2]; d = h[3];
+        e = h[4]; f = h[5]; g = h[6]; hh = h[7];
 
-        for (j = 16; j < 64; j++) {
-            SHA256_SCR(j);
+        j = 0;
+        SHA2_ROUNDS16(SHA256_EXP, SHA256_LOAD);
+        for (j = 16; j < 64; j += 16) {
+            SHA2_ROUNDS16(SHA256_EXP, SHA256_SCR);
         }
 
-        for (j = 0; j < 8; j++) {
-            wv[j] = ctx->h[j];
-        }
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+        h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+    }
+}
 
-        for (j = 0; j < 64; j++) {
-            t1 = wv[7] + SHA256_F2(wv[4]) + CH(wv[4], wv[5], wv[6])
-                + sha256_k[j] + w[j];
-            t2 = SHA256_F1(wv[0]) + MAJ(wv[0], wv[1], wv[2]);
-            wv[7] = wv[6];
-            wv[6] = wv[5];
-            wv[5] = wv[4];
-            wv[4] = wv[3] + t1;
-            wv[3] = wv[2];
-            wv[2] = wv[1];
-            wv[1] = wv[0];
-            wv[0] = t1 + t2;
-        }
+void sha256_transf(myc_sha256_ctx *ctx, const unsigned char *message,
+                   size_t block_nb)
+{
+    myc_dispatch.sha256_transf(ctx->h, message, block_nb);
+}
 
-        for (j = 0; j < 8; j++) {
-            ctx->h[j] += wv[j];
-        }
-#else
-        PACK32(&sub_block[ 0], &w[ 0]); PACK32(&sub_block[ 4], &w[ 1]);
-        PACK32(&sub_block[ 8], &w[ 2]); PACK32(&sub_block[12], &w[ 3]);
-        PACK32(&sub_block[16], &w[ 4]); PACK32(&sub_block[20], &w[ 5]);
-        PACK32(&sub_block[24], &w[ 6]); PACK32(&sub_block[28], &w[ 7]);
-        PACK32(&sub_block[32], &w[ 8]); PACK32(&sub_block[36], &w[ 9]);
-        PACK32(&sub_block[40], &w[10]); PACK32(&sub_block[44], &w[11]);
-        PACK32(&sub_block[48], &w[12]); PACK32(&sub_block[52], &w[13]);
-        PACK32(&sub_block[56], &w[14]); PACK32(&sub_block[60], &w[15]);
-
-        SHA256_SCR(16); SHA256_SCR(17); SHA256_SCR(18); SHA256_SCR(19);
-        SHA256_SCR(20); SHA256_SCR(21); SHA256_SCR(22); SHA256_SCR(23);
-        SHA256_SCR(24); SHA256_SCR(25); SHA256_SCR(26); SHA256_SCR(27);
-        SHA256_SCR(28); SHA256_SCR(29); SHA256_SCR(30); SHA256_SCR(31);
-        SHA256_SCR(32); SHA256_SCR(33); SHA256_SCR(34); SHA256_SCR(35);
-        SHA256_SCR(36); SHA256_SCR(37); SHA256_SCR(38); SHA256_SCR(39);
-        SHA256_SCR(40); SHA256_SCR(41); SHA256_SCR(42); SHA256_SCR(43);
-        SHA256_SCR(44); SHA256_SCR(45); SHA256_SCR(46); SHA256_SCR(47);
-        SHA256_SCR(48); SHA256_SCR(49); SHA256_SCR(50); SHA256_SCR(51);
-        SHA256_SCR(52); SHA256_SCR(53); SHA256_SCR(54); SHA256_SCR(55);
-        SHA256_SCR(56); SHA256_SCR(57); SHA256_SCR(58); SHA256_SCR(59);
-        SHA256_SCR(60); SHA256_SCR(61); SHA256_SCR(62); SHA256_SCR(63);
-
-        wv[0] = ctx->h[0]; wv[1] = ctx->h[1];
-        wv[2] = ctx->h[2]; wv[3] = ctx->h[3];
-        wv[4] = ctx->h[4]; wv[5] = ctx->h[5];
-        wv[6] = ctx->h[6]; wv[7] = ctx->h[7];
-
-        SHA256_EXP(0,1,2,3,4,5,6,7, 0); SHA256_EXP(7,0,1,2,3,4,5,6, 1);
-        SHA256_EXP(6,7,0,1,2,3,4,5, 2); SHA256_EXP(5,6,7,0,1,2,3,4, 3);
-        SHA256_EXP(4,5,6,7,0,1,2,3, 4); SHA256_EXP(3,4,5,6,7,0,1,2, 5);
-        SHA256_EXP(2,3,4,5,6,7,0,1, 6); SHA256_EXP(1,2,3,4,5,6,7,0, 7);
-        SHA256_EXP(0,1,2,3,4,5,6,7, 8); SHA256_EXP(7,0,1,2,3,4,5,6, 9);
-        SHA256_EXP(6,7,0,1,2,3,4,5,10); SHA256_EXP(5,6,7,0,1,2,3,4,11);
-        SHA256_EXP(4,5,6,7,0,1,2,3,12); SHA256_EXP(3,4,5,6,7,0,1,2,13);
-        SHA256_EXP(2,3,4,5,6,7,0,1,14); SHA256_EXP(1,2,3,4,5,6,7,0,15);
-        SHA256_EXP(0,1,2,3,4,5,6,7,16); SHA256_EXP(7,0,1,2,3,4,5,6,17);
-        SHA256_EXP(6,7,0,1,2,3,4,5,18); SHA256_EXP(5,6,7,0,1,2,3,4,19);
-        SHA256_EXP(4,5,6,7,0,1,2,3,20); SHA256_EXP(3,4,5,6,7,0,1,2,21);
-        SHA256_EXP(2,3,4,5,6,7,0,1,22); SHA256_EXP(1,2,3,4,5,6,7,0,23);
-        SHA256_EXP(0,1,2,3,4,5,6,7,24); SHA256_EXP(7,0,1,2,3,4,5,6,25);
-        SHA256_EXP(6,7,0,1,2,3,4,5,26); SHA256_EXP(5,6,7,0,1,2,3,4,27);
-        SHA256_EXP(4,5,6,7,0,1,2,3,28); SHA256_EXP(3,4,5,6,7,0,1,2,29);
-        SHA256_EXP(2,3,4,5,6,7,0,1,30); SHA256_EXP(1,2,3,4,5,6,7,0,31);
-        SHA256_EXP(0,1,2,3,4,5,6,7,32); SHA256_EXP(7,0,1,2,3,4,5,6,33);
-        SHA256_EXP(6,7,0,1,2,3,4,5,34); SHA256_EXP(5,6,7,0,1,2,3,4,35);
-        SHA256_EXP(4,5,6,7,0,1,2,3,36); SHA256_EXP(3,4,5,6,7,0,1,2,37);
-        SHA256_EXP(2,3,4,5,6,7,0,1,38); SHA256_EXP(1,2,3,4,5,6,7,0,39);
-        SHA256_EXP(0,1,2,3,4,5,6,7,40); SHA256_EXP(7,0,1,2,3,4,5,6,41);
-        SHA256_EXP(6,7,0,1,2,3,4,5,42); SHA256_EXP(5,6,7,0,1,2,3,4,43);
-        SHA256_EXP(4,5,6,7,0,1,2,3,44); SHA256_EXP(3,4,5,6,7,0,1,2,45);
-        SHA256_EXP(2,3,4,5,6,7,0,1,46); SHA256_EXP(1,2,3,4,5,6,7,0,47);
-        SHA256_EXP(0,1,2,3,4,5,6,7,48); SHA256_EXP(7,0,1,2,3,4,5,6,49);
-        SHA256_EXP(6,7,0,1,2,3,4,5,50); SHA256_EXP(5,6,7,0,1,2,3,4,51);
-        SHA256_EXP(4,5,6,7,0,1,2,3,52); SHA256_EXP(3,4,5,6,7,0,1,2,53);
-        SHA256_EXP(2,3,4,5,6,7,0,1,54); SHA256_EXP(1,2,3,4,5,6,7,0,55);
-        SHA256_EXP(0,1,2,3,4,5,6,7,56); SHA256_EXP(7,0,1,2,3,4,5,6,57);
-        SHA256_EXP(6,7,0,1,2,3,4,5,58); SHA256_EXP(5,6,7,0,1,2,3,4,59);
-        SHA256_EXP(4,5,6,7,0,1,2,3,60); SHA256_EXP(3,4,5,6,7,0,1,2,61);
-        SHA256_EXP(2,3,4,5,6,7,0,1,62); SHA256_EXP(1,2,3,4,5,6,7,0,63);
-
-        ctx->h[0] += wv[0]; ctx->h[1] += wv[1];
-        ctx->h[2] += wv[2]; ctx->h[3] += wv[3];
-        ctx->h[4] += wv[4]; ctx->h[5] += wv[5];
-        ctx->h[6] += wv[6]; ctx->h[7] += wv[7];
-#endif /* !UNROLL_LOOPS */
-    }
+void myc_sha256_transform(uint32 *h, const unsigned char *blocks,
+                          size_t block_nb)
+{
+    myc_dispatch.sha256_transf(h, blocks, block_nb);
 }
 
-void myc_sha256(const unsigned char *message, unsigned int len, unsigned char *digest)
+void myc_sha256(const unsigned char *message, size_t len, unsigned char *digest)
 {
     myc_sha256_ctx ctx;
 
@@ -352,19 +352,36 @@ void myc_sha256_init(myc_sha256_ctx *ctx)
 }
 
 void myc_sha256_update(myc_sha256_ctx *ctx, const unsigned char *message,
-                   unsigned int len)
+                   size_t len)
 {
-    unsigned int block_nb;
-    unsigned int new_len, rem_len, tmp_len;
+    size_t block_nb;
+    size_t new_len, rem_len, tmp_len;
     const unsigned char *shifted_message;
 
+    /* an empty message may be NULL */
+    if (len == 0)
+        return;
+
+    if (ctx->len == 0 && len >= MYC_SHA256_BLOCK_SIZE) {
+        /* nothing staged, the full blocks are hashed in place */
+        block_nb = len / MYC_SHA256_BLOCK_SIZE;
+        sha256_transf(ctx, message, block_nb);
+
+        rem_len = len % MYC_SHA256_BLOCK_SIZE;
+        memcpy(ctx->block, &message[block_nb << 6], rem_len);
+
+        ctx->len = (unsigned int) rem_len;
+        ctx->tot_len += (uint64) block_nb << 6;
+        return;
+    }
+
     tmp_len = MYC_SHA256_BLOCK_SIZE - ctx->len;
     rem_len = len < tmp_len ? len : tmp_len;
 
     memcpy(&ctx->block[ctx->len], message, rem_len);
 
     if (ctx->len + len < MYC_SHA256_BLOCK_SIZE) {
-        ctx->len += len;
+        ctx->len += (unsigned int) len;
         return;
     }
 
@@ -381,31 +398,31 @@ void myc_sha256_update(myc_sha256_ctx *ctx, const unsigned char *message,
     memcpy(ctx->block, &shifted_message[block_nb << 6],
            rem_len);
 
-    ctx->len = rem_len;
-    ctx->tot_len += (block_nb + 1) << 6;
+    ctx->len = (unsigned int) rem_len;
+    ctx->tot_len += (uint64) (block_nb + 1) << 6;
 }
 
 void myc_sha256_final(myc_sha256_ctx *ctx, unsigned char *digest)
 {
-    unsigned int block_nb;
-    unsigned int pm_len;
-    unsigned int len_b;
+    uint64 len_b;
 
 #ifndef UNROLL_LOOPS
     int i;
 #endif
 
-    block_nb = (1 + ((MYC_SHA256_BLOCK_SIZE - 9)
-                     < (ctx->len % MYC_SHA256_BLOCK_SIZE)));
-
     len_b = (ctx->tot_len + ctx->len) << 3;
-    pm_len = block_nb << 6;
 
-    memset(ctx->block + ctx->len, 0, pm_len - ctx->len);
     ctx->block[ctx->len] = 0x80;
-    UNPACK32(len_b, ctx->block + pm_len - 4);
+    memset(ctx->block + ctx->len + 1, 0,
+           MYC_SHA256_BLOCK_SIZE - ctx->len - 1);
+    if (ctx->len > MYC_SHA256_BLOCK_SIZE - 9) {
+        /* no room left for the length, it goes in one more block */
+        sha256_transf(ctx, ctx->block, 1);
+        memset(ctx->block, 0, MYC_SHA256_BLOCK_SIZE);
+    }
+    UNPACK64(len_b, ctx->block + MYC_SHA256_BLOCK_SIZE - 8);
 
-    sha256_transf(ctx, ctx->block, block_nb);
+    sha256_transf(ctx, ctx->block, 1);
 
 #ifndef UNROLL_LOOPS
     for (i = 0 ; i < 8; i++) {
@@ -425,102 +442,39 @@ void myc_sha256_final(myc_sha256_ctx *ctx, unsigned char *digest)
 
 /* SHA-512 functions */
 
-void sha512_transf(myc_sha512_ctx *ctx, const unsigned char *message,
-                   unsigned int block_nb)
+void sha512_transf_c(uint64 *h, const unsigned char *message, size_t block_nb)
 {
-    uint64 w[80];
-    uint64 wv[8];
+    uint64 w[16];
+    uint64 a, b, c, d, e, f, g, hh;
     uint64 t1, t2;
     const unsigned char *sub_block;
-    int i, j;
+    size_t i;
+    int j;
 
-    for (i = 0; i < (int) block_nb; i++) {
+    for (i = 0; i < block_nb; i++) {
         sub_block = message + (i << 7);
 
-#ifndef UNROLL_LOOPS
-        for (j = 0; j < 16; j++) {
-            PACK64(&sub_block[j << 3], &w[j]);
-        }
-
-        for (j = 16; j < 80; j++) {
-            SHA512_SCR(j);
-        }
-
-        for (j = 0; j < 8; j++) {
-            wv[j] = ctx->h[j];
-        }
-
-        for (j = 0; j < 80; j++) {
-            t1 = wv[7] + SHA512_F2(wv[4]) + CH(wv[4], wv[5], wv[6])
-                + sha512_k[j] + w[j];
-            t2 = SHA512_F1(wv[0]) + MAJ(wv[0], wv[1], wv[2]);
-            wv[7] = wv[6];
-            wv[6] = wv[5];
-            wv[5] = wv[4];
-            wv[4] = wv[3] + t1;
-            wv[3] = wv[2];
-            wv[2] = wv[1];
-            wv[1] = wv[0];
-            wv[0] = t1 + t2;
-        }
-
-        for (j = 0; j < 8; j++) {
-            ctx->h[j] += wv[j];
-        }
-#else
-        PACK64(&sub_block[  0], &w[ 0]); PACK64(&sub_block[  8], &w[ 1]);
-        PACK64(&sub_block[ 16], &w[ 2]); PACK64(&sub_block[ 24], &w[ 3]);
-        PACK64(&sub_block[ 32], &w[ 4]); PACK64(&sub_block[ 40], &w[ 5]);
-        PACK64(&sub_block[ 48], &w[ 6]); PACK64(&sub_block[ 56], &w[ 7]);
-        PACK64(&sub_block[ 64], &w[ 8]); PACK64(&sub_block[ 72], &w[ 9]);
-        PACK64(&sub_block[ 80], &w[10]); PACK64(&sub_block[ 88], &w[11]);
-        PACK64(&sub_block[ 96], &w[12]); PACK64(&sub_block[104], &w[13]);
-        PACK64(&sub_block[112], &w[14]); PACK64(&sub_block[120], &w[15]);
-
-        SHA512_SCR(16); SHA512_SCR(17); SHA512_SCR(18); SHA512_SCR(19);
-        SHA512_SCR(20); SHA512_SCR(21); SHA512_SCR(22); SHA512_SCR(23);
-        SHA512_SCR(24); SHA512_SCR(25); SHA512_SCR(26); SHA512_SCR(27);
-        SHA512_SCR(28); SHA512_SCR(29); SHA512_SCR(30); SHA512_SCR(31);
-        SHA512_SCR(32); SHA512_SCR(33); SHA512_SCR(34); SHA512_SCR(35);
-        SHA512_SCR(36); SHA512_SCR(37); SHA512_SCR(38); SHA512_SCR(39);
-        SHA512_SCR(40); SHA512_SCR(41); SHA512_SCR(42); SHA512_SCR(43);
-        SHA512_SCR(44); SHA512_SCR(45); SHA512_SCR(46); SHA512_SCR(47);
-        SHA512_SCR(48); SHA512_SCR(49); SHA512_SCR(50); SHA512_SCR(51);
-        SHA512_SCR(52); SHA512_SCR(53); SHA512_SCR(54); SHA512_SCR(55);
-        SHA512_SCR(56); SHA512_SCR(57); SHA512_SCR(58); SHA512_SCR(59);
-        SHA512_SCR(60); SHA512_SCR(61); SHA512_SCR(62); SHA512_SCR(63);
-        SHA512_SCR(64); SHA512_SCR(65); SHA512_SCR(66); SHA512_SCR(67);
-        SHA512_SCR(68); SHA512_SCR(69); SHA512_SCR(70); SHA512_SCR(71);
-        SHA512_SCR(72); SHA512_SCR(73); SHA512_SCR(74); SHA512_SCR(75);
-        SHA512_SCR(76); SHA512_SCR(77); SHA512_SCR(78); SHA512_SCR(79);
-
-        wv[0] = ctx->h[0]; wv[1] = ctx->h[1];
-        wv[2] = ctx->h[2]; wv[3] = ctx->h[3];
-        wv[4] = ctx->h[4]; wv[5] = ctx->h[5];
-        wv[6] = ctx->h[6]; wv[7] = ctx->h[7];
+        a = h[0]; b = h[1]; c = h[2]; d = h[3];
+        e = h[4]; f = h[5]; g = h[6]; hh = h[7];
 
         j = 0;
+        SHA2_ROUNDS16(SHA512_EXP, SHA512_LOAD);
+        for (j = 16; j < 80; j += 16) {
+            SHA2_ROUNDS16(SHA512_EXP, SHA512_SCR);
+        }
 
-        do {
-            SHA512_EXP(0,1,2,3,4,5,6,7,j); j++;
-            SHA512_EXP(7,0,1,2,3,4,5,6,j); j++;
-            SHA512_EXP(6,7,0,1,2,3,4,5,j); j++;
-            SHA512_EXP(5,6,7,0,1,2,3,4,j); j++;
-            SHA512_EXP(4,5,6,7,0,1,2,3,j); j++;
-            SHA512_EXP(3,4,5,6,7,0,1,2,j); j++;
-            SHA512_EXP(2,3,4,5,6,7,0,1,j); j++;
-            SHA512_EXP(1,2,3,4,5,6,7,0,j); j++;
-        } while (j < 80);
-
-        ctx->h[0] += wv[0]; ctx->h[1] += wv[1];
-        ctx->h[2] += wv[2]; ctx->h[3] += wv[3];
-        ctx->h[4] += wv[4]; ctx->h[5] += wv[5];
-        ctx->h[6] += wv[6]; ctx->h[7] += wv[7];
-#endif /* !UNROLL_LOOPS */
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+        h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
     }
 }
 
-void myc_sha512(const unsigned char *message, unsigned int len,
+void sha512_transf(myc_sha512_ctx *ctx, const unsigned char *message,
+                   size_t block_nb)
+{
+    myc_dispatch.sha512_transf(ctx->h, message, block_nb);
+}
+
+void myc_sha512(const unsigned char *message, size_t len,
             unsigned char *digest)
 {
     myc_sha512_ctx ctx;
@@ -545,23 +499,41 @@ void myc_sha512_init(myc_sha512_ctx *ctx)
 #endif /* !UNROLL_LOOPS */
 
     ctx->len = 0;
-    ctx->tot_len = 0;
+    ctx->tot_len[0] = 0;
+    ctx->tot_len[1] = 0;
 }
 
 void myc_sha512_update(myc_sha512_ctx *ctx, const unsigned char *message,
-                   unsigned int len)
+                   size_t len)
 {
-    unsigned int block_nb;
-    unsigned int new_len, rem_len, tmp_len;
+    size_t block_nb;
+    size_t new_len, rem_len, tmp_len;
     const unsigned char *shifted_message;
 
+    /* an empty message may be NULL */
+    if (len == 0)
+        return;
+
+    if (ctx->len == 0 && len >= MYC_SHA512_BLOCK_SIZE) {
+        /* nothing staged, the full blocks are hashed in place */
+        block_nb = len / MYC_SHA512_BLOCK_SIZE;
+        sha512_transf(ctx, message, block_nb);
+
+        rem_len = len % MYC_SHA512_BLOCK_SIZE;
+        memcpy(ctx->block, &message[block_nb << 7], rem_len);
+
+        ctx->len = (unsigned int) rem_len;
+        SHA512_ADD_LEN(ctx, (uint64) block_nb << 7);
+        return;
+    }
+
     tmp_len = MYC_SHA512_BLOCK_SIZE - ctx->len;
     rem_len = len < tmp_len ? len : tmp_len;
 
     memcpy(&ctx->block[ctx->len], message, rem_len);
 
     if (ctx->len + len < MYC_SHA512_BLOCK_SIZE) {
-        ctx->len += len;
+        ctx->len += (unsigned int) len;
         return;
     }
 
@@ -578,31 +550,35 @@ void myc_sha512_update(myc_sha512_ctx *ctx, const unsigned char *message,
     memcpy(ctx->block, &shifted_message[block_nb << 7],
            rem_len);
 
-    ctx->len = rem_len;
-    ctx->tot_len += (block_nb + 1) << 7;
+    ctx->len = (unsigned int) rem_len;
+    SHA512_ADD_LEN(ctx, (uint64) (block_nb + 1) << 7);
 }
 
 void myc_sha512_final(myc_sha512_ctx *ctx, unsigned char *digest)
 {
-    unsigned int block_nb;
-    unsigned int pm_len;
-    unsigned int len_b;
+    uint64 len_b, len_hi;
 
 #ifndef UNROLL_LOOPS
     int i;
 #endif
 
-    block_nb = 1 + ((MYC_SHA512_BLOCK_SIZE - 17)
-                     < (ctx->len % MYC_SHA512_BLOCK_SIZE));
-
-    len_b = (ctx->tot_len + ctx->len) << 3;
-    pm_len = block_nb << 7;
+    len_b = ctx->tot_len[0] + ctx->len;
+    len_hi = ctx->tot_len[1] + (len_b < ctx->len);
+    len_hi = (len_hi << 3) | (len_b >> 61);
+    len_b <<= 3;
 
-    memset(ctx->block + ctx->len, 0, pm_len - ctx->len);
     ctx->block[ctx->len] = 0x80;
-    UNPACK32(len_b, ctx->block + pm_len - 4);
+    memset(ctx->block + ctx->len + 1, 0,
+           MYC_SHA512_BLOCK_SIZE - ctx->len - 1);
+    if (ctx->len > MYC_SHA512_BLOCK_SIZE - 17) {
+        /* no room left for the length, it goes in one more block */
+        sha512_transf(ctx, ctx->block, 1);
+        memset(ctx->block, 0, MYC_SHA512_BLOCK_SIZE);
+    }
+    UNPACK64(len_hi, ctx->block + MYC_SHA512_BLOCK_SIZE - 16);
+    UNPACK64(len_b, ctx->block + MYC_SHA512_BLOCK_SIZE - 8);
 
-    sha512_transf(ctx, ctx->block, block_nb);
+    sha512_transf(ctx, ctx->block, 1);
 
 #ifndef UNROLL_LOOPS
     for (i = 0 ; i < 8; i++) {
@@ -622,7 +598,7 @@ void myc_sha512_final(myc_sha512_ctx *ctx, unsigned char *digest)
 
 /* SHA-384 functions */
 
-void myc_sha384(const unsigned char *message, unsigned int len,
+void myc_sha384(const unsigned char *message, size_t len,
             unsigned char *digest)
 {
     myc_sha384_ctx ctx;
@@ -647,23 +623,41 @@ void myc_sha384_init(myc_sha384_ctx *ctx)
 #endif /* !UNROLL_LOOPS */
 
     ctx->len = 0;
-    ctx->tot_len = 0;
+    ctx->tot_len[0] = 0;
+    ctx->tot_len[1] = 0;
 }
 
 void myc_sha384_update(myc_sha384_ctx *ctx, const unsigned char *message,
-                   unsigned int len)
+                   size_t len)
 {
-    unsigned int block_nb;
-    unsigned int new_len, rem_len, tmp_len;
+    size_t block_nb;
+    size_t new_len, rem_len, tmp_len;
     const unsigned char *shifted_message;
 
+    /* an empty message may be NULL */
+    if (len == 0)
+        return;
+
+    if (ctx->len == 0 && len >= MYC_SHA384_BLOCK_SIZE) {
+        /* nothing staged, the full blocks are hashed in place */
+        block_nb = len / MYC_SHA384_BLOCK_SIZE;
+        sha512_transf(ctx, message, block_nb);
+
+        rem_len = len % MYC_SHA384_BLOCK_SIZE;
+        memcpy(ctx->block, &message[block_nb << 7], rem_len);
+
+        ctx->len = (unsigned int) rem_len;
+        SHA512_ADD_LEN(ctx, (uint64) block_nb << 7);
+        return;
+    }
+
     tmp_len = MYC_SHA384_BLOCK_SIZE - ctx->len;
     rem_len = len < tmp_len ? len : tmp_len;
 
     memcpy(&ctx->block[ctx->len], message, rem_len);
 
     if (ctx->len + len < MYC_SHA384_BLOCK_SIZE) {
-        ctx->len += len;
+        ctx->len += (unsigned int) len;
         return;
     }
 
@@ -680,31 +674,35 @@ void myc_sha384_update(myc_sha384_ctx *ctx, const unsigned char *message,
     memcpy(ctx->block, &shifted_message[block_nb << 7],
            rem_len);
 
-    ctx->len = rem_len;
-    ctx->tot_len += (block_nb + 1) << 7;
+    ctx->len = (unsigned int) rem_len;
+    SHA512_ADD_LEN(ctx, (uint64) (block_nb + 1) << 7);
 }
 
 void myc_sha384_final(myc_sha384_ctx *ctx, unsigned char *digest)
 {
-    unsigned int block_nb;
-    unsigned int pm_len;
-    unsigned int len_b;
+    uint64 len_b, len_hi;
 
 #ifndef UNROLL_LOOPS
     int i;
 #endif
 
-    block_nb = (1 + ((MYC_SHA384_BLOCK_SIZE - 17)
-                     < (ctx->len % MYC_SHA384_BLOCK_SIZE)));
-
-    len_b = (ctx->tot_len + ctx->len) << 3;
-    pm_len = block_nb << 7;
+    len_b = ctx->tot_len[0] + ctx->len;
+    len_hi = ctx->tot_len[1] + (len_b < ctx->len);
+    len_hi = (len_hi << 3) | (len_b >> 61);
+    len_b <<= 3;
 
-    memset(ctx->block + ctx->len, 0, pm_len - ctx->len);
     ctx->block[ctx->len] = 0x80;
-    UNPACK32(len_b, ctx->block + pm_len - 4);
+    memset(ctx->block + ctx->len + 1, 0,
+           MYC_SHA384_BLOCK_SIZE - ctx->len - 1);
+    if (ctx->len > MYC_SHA384_BLOCK_SIZE - 17) {
+        /* no room left for the length, it goes in one more block */
+        sha512_transf(ctx, ctx->block, 1);
+        memset(ctx->block, 0, MYC_SHA384_BLOCK_SIZE);
+    }
+    UNPACK64(len_hi, ctx->block + MYC_SHA384_BLOCK_SIZE - 16);
+    UNPACK64(len_b, ctx->block + MYC_SHA384_BLOCK_SIZE - 8);
 
-    sha512_transf(ctx, ctx->block, block_nb);
+    sha512_transf(ctx, ctx->block, 1);
 
 #ifndef UNROLL_LOOPS
     for (i = 0 ; i < 6; i++) {
@@ -722,7 +720,7 @@ void myc_sha384_final(myc_sha384_ctx *ctx, unsigned char *digest)
 
 /* SHA-224 functions */
 
-void myc_sha224(const unsigned char *message, unsigned int len,
+void myc_sha224(const unsigned char *message, size_t len,
             unsigned char *digest)
 {
     myc_sha224_ctx ctx;
@@ -751,19 +749,36 @@ void myc_sha224_init(myc_sha224_ctx *ctx)
 }
 
 void myc_sha224_update(myc_sha224_ctx *ctx, const unsigned char *message,
-                   unsigned int len)
+                   size_t len)
 {
-    unsigned int block_nb;
-    unsigned int new_len, rem_len, tmp_len;
+    size_t block_nb;
+    size_t new_len, rem_len, tmp_len;
     const unsigned char *shifted_message;
 
+    /* an empty message may be NULL */
+    if (len == 0)
+        return;
+
+    if (ctx->len == 0 && len >= MYC_SHA224_BLOCK_SIZE) {
+        /* nothing staged, the full blocks are hashed in place */
+        block_nb = len / MYC_SHA224_BLOCK_SIZE;
+        sha256_transf(ctx, message, block_nb);
+
+        rem_len = len % MYC_SHA224_BLOCK_SIZE;
+        memcpy(ctx->block, &message[block_nb << 6], rem_len);
+
+        ctx->len = (unsigned int) rem_len;
+        ctx->tot_len += (uint64) block_nb << 6;
+        return;
+    }
+
     tmp_len = MYC_SHA224_BLOCK_SIZE - ctx->len;
     rem_len = len < tmp_len ? len : tmp_len;
 
     memcpy(&ctx->block[ctx->len], message, rem_len);
 
     if (ctx->len + len < MYC_SHA224_BLOCK_SIZE) {
-        ctx->len += len;
+        ctx->len += (unsigned int) len;
         return;
     }
 
@@ -780,31 +795,31 @@ void myc_sha224_update(myc_sha224_ctx *ctx, const unsigned char *message,
     memcpy(ctx->block, &shifted_message[block_nb << 6],
            rem_len);
 
-    ctx->len = rem_len;
-    ctx->tot_len += (block_nb + 1) << 6;
+    ctx->len = (unsigned int) rem_len;
+    ctx->tot_len += (uint64) (block_nb + 1) << 6;
 }
 
 void myc_sha224_final(myc_sha224_ctx *ctx, unsigned char *digest)
 {
-    unsigned int block_nb;
-    unsigned int pm_len;
-    unsigned int len_b;
+    uint64 len_b;
 
 #ifndef UNROLL_LOOPS
     int i;
 #endif
 
-    block_nb = (1 + ((MYC_SHA224_BLOCK_SIZE - 9)
-                     < (ctx->len % MYC_SHA224_BLOCK_SIZE)));
-
     len_b = (ctx->tot_len + ctx->len) << 3;
-    pm_len = block_nb << 6;
 
-    memset(ctx->block + ctx->len, 0, pm_len - ctx->len);
     ctx->block[ctx->len] = 0x80;
-    UNPACK32(len_b, ctx->block + pm_len - 4);
+    memset(ctx->block + ctx->len + 1, 0,
+           MYC_SHA224_BLOCK_SIZE - ctx->len - 1);
+    if (ctx->len > MYC_SHA224_BLOCK_SIZE - 9) {
+        /* no room left for the length, it goes in one more block */
+        sha256_transf(ctx, ctx->block, 1);
+        memset(ctx->block, 0, MYC_SHA224_BLOCK_SIZE);
+    }
+    UNPACK64(len_b, ctx->block + MYC_SHA224_BLOCK_SIZE - 8);
 
-    sha256_transf(ctx, ctx->block, block_nb);
+    sha256_transf(ctx, ctx->block, 1);
 
 #ifndef UNROLL_LOOPS
     for (i = 0 ; i < 7; i++) {
@@ -821,6 +836,80 @@ void myc_sha224_final(myc_sha224_ctx *ctx, unsigned char *digest)
 #endif /* !UNROLL_LOOPS */
 }
 
+/*
+ * Digests of the input so far. The chaining state, the counters and
+ * the bytes of the partial block are copied to a context on the stack,
+ * which is finalized instead, so that ctx can still be updated.
+ */
+
+static void sha256_copy_state(myc_sha256_ctx *copy,
+                              const myc_sha256_ctx *ctx)
+{
+    memcpy(copy->h, ctx->h, sizeof(ctx->h));
+    copy->tot_len = ctx->tot_len;
+    copy->len = ctx->len;
+    memcpy(copy->block, ctx->block, ctx->len);
+}
+
+static void sha512_copy_state(myc_sha512_ctx *copy,
+                              const myc_sha512_ctx *ctx)
+{
+    memcpy(copy->h, ctx->h, sizeof(ctx->h));
+    copy->tot_len[0] = ctx->tot_len[0];
+    copy->tot_len[1] = ctx->tot_len[1];
+    copy->len = ctx->len;
+    memcpy(copy->block, ctx->block, ctx->len);
+}
+
+void myc_sha224_peek(const myc_sha224_ctx *ctx, unsigned char *digest)
+{
+    myc_sha224_ctx copy;
+
+    sha256_copy_state(&copy, ctx);
+    myc_sha224_final(&copy, digest);
+}
+
+void myc_sha256_peek(const myc_sha256_ctx *ctx, unsigned char *digest)
+{
+    myc_sha256_ctx copy;
+
+    sha256_copy_state(&copy, ctx);
+    myc_sha256_final(&copy, digest);
+}
+
+void myc_sha384_peek(const myc_sha384_ctx *ctx, unsigned char *digest)
+{
+    myc_sha384_ctx copy;
+
+    sha512_copy_state(&copy, ctx);
+    myc_sha384_final(&copy, digest);
+}
+
+void myc_sha512_peek(const myc_sha512_ctx *ctx, unsigned char *digest)
+{
+    myc_sha512_ctx copy;
+
+    sha512_copy_state(&copy, ctx);
+    myc_sha512_final(&copy, digest);
+}
+
+#define SHA2_UPDATEV(name)                                              \
+void myc_##name##_updatev(myc_##name##_ctx *ctx, const struct iovec *iov, \
+                          int cnt)                                      \
+{                                                                       \
+    int i;                                                              \
+                                                                        \
+    for (i = 0; i < cnt; i++) {                                         \
+        myc_##name##_update(ctx, (const unsigned char *) iov[i].iov_base, \
+                            iov[i].iov_len);                            \
+    }                                                                   \
+}
+
+SHA2_UPDATEV(sha224)
+SHA2_UPDATEV(sha256)
+SHA2_UPDATEV(sha384)
+SHA2_UPDATEV(sha512)
+
 #ifdef TEST_VECTORS
 
 /* FIPS 180-2 Validation tests */
@@ -0,0 +1,154 @@
+/*
+ * SHA-224/256 block transform with a two-block SIMD schedule (AVX2)
+ *
+ * Blocks are taken in pairs, the message schedule of the first block
+ * being computed in the low half of ymm registers and the one of the
+ * second block in the high half. The rounds of the first block are
+ * interleaved with the schedule as in the SSSE3 transform, all the
+ * scheduled words plus round constants being kept so that the rounds
+ * of the second block then run without any schedule work. The rounds
+ * use RORX and ANDN from BMI1/BMI2.
+ */
+
+#include "dispatch.h"
+
+#ifdef MYC_X86
+
+#include <immintrin.h>
+
+#define AVX2_TARGET __attribute__((target("avx2,bmi,bmi2")))
+
+#define ROTR(x, n)   ((x >> n) | (x << (32 - n)))
+#define CH(x, y, z)  ((x & y) ^ (~x & z))
+#define MAJ(x, y, z) ((x & y) | (z & (x | y)))
+
+#define S0(x) (ROTR(x,  2) ^ ROTR(x, 13) ^ ROTR(x, 22))
+#define S1(x) (ROTR(x,  6) ^ ROTR(x, 11) ^ ROTR(x, 25))
+
+#define ROUND(a, b, c, d, e, f, g, h, wk)                               \
+{                                                                       \
+    t1 = h + S1(e) + CH(e, f, g) + (wk);                                \
+    t2 = S0(a) + MAJ(a, b, c);                                          \
+    d += t1;                                                            \
+    h = t1 + t2;                                                        \
+}
+
+/* Four rounds with W+K read from p[0..3] */
+#define ROUND4(a, b, c, d, e, f, g, h, p)                               \
+{                                                                       \
+    ROUND(a, b, c, d, e, f, g, h, (p)[0]);                              \
+    ROUND(h, a, b, c, d, e, f, g, (p)[1]);                              \
+    ROUND(g, h, a, b, c, d, e, f, (p)[2]);                              \
+    ROUND(f, g, h, a, b, c, d, e, (p)[3]);                              \
+}
+
+/*
+ * W+K of rounds j..j+3 are at wk[2 * j] for the first block and at
+ * wk[2 * j + 4] for the second one.
+ */
+#define WK0(j) (&wk[2 * (j)])
+#define WK1(j) (&wk[2 * (j) + 4])
+
+#define YROTR(x, n) _mm256_or_si256(_mm256_srli_epi32(x, n),            \
+                                    _mm256_slli_epi32(x, 32 - (n)))
+
+/* Same as XSIGMA1_2() in the SSSE3 transform, on each 128-bit half */
+#define YSIGMA1_2(x)                                                    \
+    _mm256_shuffle_epi32(_mm256_xor_si256(_mm256_xor_si256(             \
+        _mm256_srli_epi32(x, 10), _mm256_srli_epi64(x, 17)),            \
+        _mm256_srli_epi64(x, 19)), 0x08)
+
+#define YSCHED(x0, x1, x2, x3)                                          \
+{                                                                       \
+    w15 = _mm256_alignr_epi8(x1, x0, 4);                                \
+    w7 = _mm256_alignr_epi8(x3, x2, 4);                                 \
+    x0 = _mm256_add_epi32(_mm256_add_epi32(x0, w7),                     \
+             _mm256_xor_si256(_mm256_xor_si256(YROTR(w15, 7),           \
+                                               YROTR(w15, 18)),         \
+                              _mm256_srli_epi32(w15, 3)));              \
+    tmp = _mm256_shuffle_epi32(x3, 0xFA);                               \
+    x0 = _mm256_add_epi32(x0, _mm256_blend_epi32(zero,                  \
+                                                 YSIGMA1_2(tmp), 0x33));\
+    tmp = _mm256_shuffle_epi32(x0, 0x50);                               \
+    x0 = _mm256_add_epi32(x0, _mm256_bslli_epi128(YSIGMA1_2(tmp), 8));  \
+}
+
+#define YSTORE_WK(x, j)                                                 \
+    _mm256_store_si256((__m256i *) WK0(j), _mm256_add_epi32(x,          \
+        _mm256_broadcastsi128_si256(                                    \
+            _mm_loadu_si128((const __m128i *) &sha256_k[j]))))
+
+#define SCHED_ROUND4(x0, x1, x2, x3, a, b, c, d, e, f, g, h, j)         \
+{                                                                       \
+    YSCHED(x0, x1, x2, x3);                                             \
+    ROUND4(a, b, c, d, e, f, g, h, WK0(j));                             \
+    YSTORE_WK(x0, (j) + 16);                                            \
+}
+
+#define YLOAD(x, offset)                                                \
+    x = _mm256_shuffle_epi8(_mm256_inserti128_si256(                    \
+            _mm256_castsi128_si256(_mm_loadu_si128(                     \
+                (const __m128i *) (message + (offset)))),               \
+            _mm_loadu_si128((const __m128i *) (next + (offset))), 1),   \
+            bswap)
+
+#define FEED_FORWARD()                                                  \
+{                                                                       \
+    a = h[0] += a; b = h[1] += b; c = h[2] += c; d = h[3] += d;         \
+    e = h[4] += e; f = h[5] += f; g = h[6] += g; hh = h[7] += hh;       \
+}
+
+AVX2_TARGET
+void sha256_transf_avx2(uint32 *h, const unsigned char *message,
+                        size_t block_nb)
+{
+    const __m256i bswap = _mm256_set_epi8(
+        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    const __m256i zero = _mm256_setzero_si256();
+    uint32 wk[2 * 64] __attribute__((aligned(32)));
+    uint32 a, b, c, d, e, f, g, hh, t1, t2;
+    __m256i x0, x1, x2, x3, w15, w7, tmp;
+    int j;
+
+    a = h[0]; b = h[1]; c = h[2]; d = h[3];
+    e = h[4]; f = h[5]; g = h[6]; hh = h[7];
+
+    while (block_nb > 0) {
+        /* A last odd block is scheduled twice, the copy being unused */
+        const unsigned char *next = message;
+
+        if (block_nb > 1)
+            next += MYC_SHA256_BLOCK_SIZE;
+
+        YLOAD(x0,  0); YLOAD(x1, 16); YLOAD(x2, 32); YLOAD(x3, 48);
+        YSTORE_WK(x0, 0); YSTORE_WK(x1, 4);
+        YSTORE_WK(x2, 8); YSTORE_WK(x3, 12);
+
+        for (j = 0; j < 48; j += 16) {
+            SCHED_ROUND4(x0, x1, x2, x3, a, b, c, d, e, f, g, hh, j +  0);
+            SCHED_ROUND4(x1, x2, x3, x0, e, f, g, hh, a, b, c, d, j +  4);
+            SCHED_ROUND4(x2, x3, x0, x1, a, b, c, d, e, f, g, hh, j +  8);
+            SCHED_ROUND4(x3, x0, x1, x2, e, f, g, hh, a, b, c, d, j + 12);
+        }
+        for (; j < 64; j += 8) {
+            ROUND4(a, b, c, d, e, f, g, hh, WK0(j));
+            ROUND4(e, f, g, hh, a, b, c, d, WK0(j + 4));
+        }
+        FEED_FORWARD();
+
+        if (block_nb == 1)
+            break;
+
+        for (j = 0; j < 64; j += 8) {
+            ROUND4(a, b, c, d, e, f, g, hh, WK1(j));
+            ROUND4(e, f, g, hh, a, b, c, d, WK1(j + 4));
+        }
+        FEED_FORWARD();
+
+        message += 2 * MYC_SHA256_BLOCK_SIZE;
+        block_nb -= 2;
+    }
+}
+
+#endif /* MYC_X86 */
@@ -0,0 +1,165 @@
+/*
+ * 8-lane multi-buffer SHA-224/256 block transform (AVX2)
+ *
+ * Each 32-bit lane of a ymm register carries one independent message
+ * stream. The chaining state is stored word-major: state[i * 8 + l] is
+ * word i of lane l, so every state word is one vector.
+ */
+
+#include "dispatch.h"
+
+#ifdef MYC_X86
+
+#include <immintrin.h>
+
+#define MB_TARGET __attribute__((target("avx2")))
+
+#define ROTR32(x, n) _mm256_or_si256(_mm256_srli_epi32(x, n),            \
+                                     _mm256_slli_epi32(x, 32 - (n)))
+
+#define S0(x) _mm256_xor_si256(_mm256_xor_si256(ROTR32(x,  2),           \
+                               ROTR32(x, 13)), ROTR32(x, 22))
+#define S1(x) _mm256_xor_si256(_mm256_xor_si256(ROTR32(x,  6),           \
+                               ROTR32(x, 11)), ROTR32(x, 25))
+#define s0(x) _mm256_xor_si256(_mm256_xor_si256(ROTR32(x,  7),           \
+                               ROTR32(x, 18)), _mm256_srli_epi32(x,  3))
+#define s1(x) _mm256_xor_si256(_mm256_xor_si256(ROTR32(x, 17),           \
+                               ROTR32(x, 19)), _mm256_srli_epi32(x, 10))
+
+#define CH(x, y, z)  _mm256_xor_si256(_mm256_and_si256(x, y),             \
+                                      _mm256_andnot_si256(x, z))
+#define MAJ(x, y, z) _mm256_or_si256(_mm256_and_si256(x, y),              \
+                         _mm256_and_si256(z, _mm256_or_si256(x, y)))
+
+#define ADD(x, y) _mm256_add_epi32(x, y)
+
+/* Message schedule word t >= 16, kept in a circular 16-entry buffer */
+#define SCHED(t)                                                        \
+{                                                                       \
+    w[(t) & 15] = ADD(ADD(w[(t) & 15], s0(w[((t) - 15) & 15])),         \
+                      ADD(w[((t) - 7) & 15], s1(w[((t) - 2) & 15])));   \
+}
+
+#define ROUND(a, b, c, d, e, f, g, h, t)                                \
+{                                                                       \
+    t1 = ADD(ADD(ADD(h, S1(e)), ADD(CH(e, f, g), w[(t) & 15])),         \
+             _mm256_set1_epi32((int) sha256_k[t]));                     \
+    t2 = ADD(S0(a), MAJ(a, b, c));                                      \
+    d = ADD(d, t1);                                                     \
+    h = ADD(t1, t2);                                                    \
+}
+
+#define ROUND8(t)                                                       \
+{                                                                       \
+    ROUND(a, b, c, d, e, f, g, h, (t) + 0);                             \
+    ROUND(h, a, b, c, d, e, f, g, (t) + 1);                             \
+    ROUND(g, h, a, b, c, d, e, f, (t) + 2);                             \
+    ROUND(f, g, h, a, b, c, d, e, (t) + 3);                             \
+    ROUND(e, f, g, h, a, b, c, d, (t) + 4);                             \
+    ROUND(d, e, f, g, h, a, b, c, (t) + 5);                             \
+    ROUND(c, d, e, f, g, h, a, b, (t) + 6);                             \
+    ROUND(b, c, d, e, f, g, h, a, (t) + 7);                             \
+}
+
+#define SCHED8(t)                                                       \
+{                                                                       \
+    SCHED((t) + 0); SCHED((t) + 1); SCHED((t) + 2); SCHED((t) + 3);     \
+    SCHED((t) + 4); SCHED((t) + 5); SCHED((t) + 6); SCHED((t) + 7);     \
+}
+
+/* Load 8 big-endian words from each lane, transposed to word-major */
+MB_TARGET
+static void load_words(__m256i *out, const unsigned char *const *data,
+                       size_t offset)
+{
+    const __m256i bswap = _mm256_set_epi8(
+        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    __m256i r0, r1, r2, r3, r4, r5, r6, r7;
+    __m256i t0, t1, t2, t3, t4, t5, t6, t7;
+
+    r0 = _mm256_loadu_si256((const __m256i *) (data[0] + offset));
+    r1 = _mm256_loadu_si256((const __m256i *) (data[1] + offset));
+    r2 = _mm256_loadu_si256((const __m256i *) (data[2] + offset));
+    r3 = _mm256_loadu_si256((const __m256i *) (data[3] + offset));
+    r4 = _mm256_loadu_si256((const __m256i *) (data[4] + offset));
+    r5 = _mm256_loadu_si256((const __m256i *) (data[5] + offset));
+    r6 = _mm256_loadu_si256((const __m256i *) (data[6] + offset));
+    r7 = _mm256_loadu_si256((const __m256i *) (data[7] + offset));
+
+    t0 = _mm256_unpacklo_epi32(r0, r1);
+    t1 = _mm256_unpackhi_epi32(r0, r1);
+    t2 = _mm256_unpacklo_epi32(r2, r3);
+    t3 = _mm256_unpackhi_epi32(r2, r3);
+    t4 = _mm256_unpacklo_epi32(r4, r5);
+    t5 = _mm256_unpackhi_epi32(r4, r5);
+    t6 = _mm256_unpacklo_epi32(r6, r7);
+    t7 = _mm256_unpackhi_epi32(r6, r7);
+
+    r0 = _mm256_unpacklo_epi64(t0, t2);
+    r1 = _mm256_unpackhi_epi64(t0, t2);
+    r2 = _mm256_unpacklo_epi64(t1, t3);
+    r3 = _mm256_unpackhi_epi64(t1, t3);
+    r4 = _mm256_unpacklo_epi64(t4, t6);
+    r5 = _mm256_unpackhi_epi64(t4, t6);
+    r6 = _mm256_unpacklo_epi64(t5, t7);
+    r7 = _mm256_unpackhi_epi64(t5, t7);
+
+    out[0] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r0, r4, 0x20),
+                                 bswap);
+    out[1] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r1, r5, 0x20),
+                                 bswap);
+    out[2] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r2, r6, 0x20),
+                                 bswap);
+    out[3] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r3, r7, 0x20),
+                                 bswap);
+    out[4] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r0, r4, 0x31),
+                                 bswap);
+    out[5] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r1, r5, 0x31),
+                                 bswap);
+    out[6] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r2, r6, 0x31),
+                                 bswap);
+    out[7] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r3, r7, 0x31),
+                                 bswap);
+}
+
+MB_TARGET
+void sha256_transf_x8_avx2(uint32 *state, const unsigned char *const *data,
+                           size_t block_nb)
+{
+    __m256i a, b, c, d, e, f, g, h, t1, t2;
+    __m256i w[16];
+    size_t i;
+
+    for (i = 0; i < block_nb; i++) {
+        size_t offset = i * MYC_SHA256_BLOCK_SIZE;
+
+        load_words(&w[0], data, offset);
+        load_words(&w[8], data, offset + 32);
+
+        a = _mm256_loadu_si256((const __m256i *) &state[0 * 8]);
+        b = _mm256_loadu_si256((const __m256i *) &state[1 * 8]);
+        c = _mm256_loadu_si256((const __m256i *) &state[2 * 8]);
+        d = _mm256_loadu_si256((const __m256i *) &state[3 * 8]);
+        e = _mm256_loadu_si256((const __m256i *) &state[4 * 8]);
+        f = _mm256_loadu_si256((const __m256i *) &state[5 * 8]);
+        g = _mm256_loadu_si256((const __m256i *) &state[6 * 8]);
+        h = _mm256_loadu_si256((const __m256i *) &state[7 * 8]);
+
+        ROUND8( 0); ROUND8( 8);
+        SCHED8(16); ROUND8(16); SCHED8(24); ROUND8(24);
+        SCHED8(32); ROUND8(32); SCHED8(40); ROUND8(40);
+        SCHED8(48); ROUND8(48); SCHED8(56); ROUND8(56);
+
+#define STORE_ADD(i, x)                                                 \
+        _mm256_storeu_si256((__m256i *) &state[(i) * 8],                \
+            ADD(x, _mm256_loadu_si256((const __m256i *) &state[(i) * 8])))
+
+        STORE_ADD(0, a); STORE_ADD(1, b); STORE_ADD(2, c); STORE_ADD(3, d);
+        STORE_ADD(4, e); STORE_ADD(5, f); STORE_ADD(6, g); STORE_ADD(7, h);
+
+#undef STORE_ADD
+    }
+}
+
+#endif /* MYC_X86 */
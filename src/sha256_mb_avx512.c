@@ -0,0 +1,172 @@
+/*
+ * 16-lane multi-buffer SHA-224/256 block transform (AVX-512)
+ *
+ * Same layout as the AVX2 transform with one stream per 32-bit lane of
+ * a zmm register. Rotations use vprord and the three-input boolean
+ * functions (Ch, Maj and the sigma XORs) a single vpternlogd each.
+ */
+
+#include "dispatch.h"
+
+#ifdef MYC_X86
+
+#include <immintrin.h>
+
+#define MB_TARGET __attribute__((target("avx512f")))
+
+#define XOR3(x, y, z) _mm512_ternarylogic_epi32(x, y, z, 0x96)
+
+#define S0(x) XOR3(_mm512_ror_epi32(x,  2), _mm512_ror_epi32(x, 13),      \
+                   _mm512_ror_epi32(x, 22))
+#define S1(x) XOR3(_mm512_ror_epi32(x,  6), _mm512_ror_epi32(x, 11),      \
+                   _mm512_ror_epi32(x, 25))
+#define s0(x) XOR3(_mm512_ror_epi32(x,  7), _mm512_ror_epi32(x, 18),      \
+                   _mm512_srli_epi32(x,  3))
+#define s1(x) XOR3(_mm512_ror_epi32(x, 17), _mm512_ror_epi32(x, 19),      \
+                   _mm512_srli_epi32(x, 10))
+
+#define CH(x, y, z)  _mm512_ternarylogic_epi32(x, y, z, 0xCA)
+#define MAJ(x, y, z) _mm512_ternarylogic_epi32(x, y, z, 0xE8)
+
+#define ADD(x, y) _mm512_add_epi32(x, y)
+
+#define SCHED(t)                                                        \
+{                                                                       \
+    w[(t) & 15] = ADD(ADD(w[(t) & 15], s0(w[((t) - 15) & 15])),         \
+                      ADD(w[((t) - 7) & 15], s1(w[((t) - 2) & 15])));   \
+}
+
+#define ROUND(a, b, c, d, e, f, g, h, t)                                \
+{                                                                       \
+    t1 = ADD(ADD(ADD(h, S1(e)), ADD(CH(e, f, g), w[(t) & 15])),         \
+             _mm512_set1_epi32((int) sha256_k[t]));                     \
+    t2 = ADD(S0(a), MAJ(a, b, c));                                      \
+    d = ADD(d, t1);                                                     \
+    h = ADD(t1, t2);                                                    \
+}
+
+#define ROUND8(t)                                                       \
+{                                                                       \
+    ROUND(a, b, c, d, e, f, g, h, (t) + 0);                             \
+    ROUND(h, a, b, c, d, e, f, g, (t) + 1);                             \
+    ROUND(g, h, a, b, c, d, e, f, (t) + 2);                             \
+    ROUND(f, g, h, a, b, c, d, e, (t) + 3);                             \
+    ROUND(e, f, g, h, a, b, c, d, (t) + 4);                             \
+    ROUND(d, e, f, g, h, a, b, c, (t) + 5);                             \
+    ROUND(c, d, e, f, g, h, a, b, (t) + 6);                             \
+    ROUND(b, c, d, e, f, g, h, a, (t) + 7);                             \
+}
+
+#define SCHED8(t)                                                       \
+{                                                                       \
+    SCHED((t) + 0); SCHED((t) + 1); SCHED((t) + 2); SCHED((t) + 3);     \
+    SCHED((t) + 4); SCHED((t) + 5); SCHED((t) + 6); SCHED((t) + 7);     \
+}
+
+/* Transpose 8 words of 8 lanes, out[i] holds word i of every lane */
+MB_TARGET
+static void transpose8(__m256i *out, const unsigned char *const *data,
+                       size_t offset)
+{
+    __m256i r0, r1, r2, r3, r4, r5, r6, r7;
+    __m256i t0, t1, t2, t3, t4, t5, t6, t7;
+
+    r0 = _mm256_loadu_si256((const __m256i *) (data[0] + offset));
+    r1 = _mm256_loadu_si256((const __m256i *) (data[1] + offset));
+    r2 = _mm256_loadu_si256((const __m256i *) (data[2] + offset));
+    r3 = _mm256_loadu_si256((const __m256i *) (data[3] + offset));
+    r4 = _mm256_loadu_si256((const __m256i *) (data[4] + offset));
+    r5 = _mm256_loadu_si256((const __m256i *) (data[5] + offset));
+    r6 = _mm256_loadu_si256((const __m256i *) (data[6] + offset));
+    r7 = _mm256_loadu_si256((const __m256i *) (data[7] + offset));
+
+    t0 = _mm256_unpacklo_epi32(r0, r1);
+    t1 = _mm256_unpackhi_epi32(r0, r1);
+    t2 = _mm256_unpacklo_epi32(r2, r3);
+    t3 = _mm256_unpackhi_epi32(r2, r3);
+    t4 = _mm256_unpacklo_epi32(r4, r5);
+    t5 = _mm256_unpackhi_epi32(r4, r5);
+    t6 = _mm256_unpacklo_epi32(r6, r7);
+    t7 = _mm256_unpackhi_epi32(r6, r7);
+
+    r0 = _mm256_unpacklo_epi64(t0, t2);
+    r1 = _mm256_unpackhi_epi64(t0, t2);
+    r2 = _mm256_unpacklo_epi64(t1, t3);
+    r3 = _mm256_unpackhi_epi64(t1, t3);
+    r4 = _mm256_unpacklo_epi64(t4, t6);
+    r5 = _mm256_unpackhi_epi64(t4, t6);
+    r6 = _mm256_unpacklo_epi64(t5, t7);
+    r7 = _mm256_unpackhi_epi64(t5, t7);
+
+    out[0] = _mm256_permute2x128_si256(r0, r4, 0x20);
+    out[1] = _mm256_permute2x128_si256(r1, r5, 0x20);
+    out[2] = _mm256_permute2x128_si256(r2, r6, 0x20);
+    out[3] = _mm256_permute2x128_si256(r3, r7, 0x20);
+    out[4] = _mm256_permute2x128_si256(r0, r4, 0x31);
+    out[5] = _mm256_permute2x128_si256(r1, r5, 0x31);
+    out[6] = _mm256_permute2x128_si256(r2, r6, 0x31);
+    out[7] = _mm256_permute2x128_si256(r3, r7, 0x31);
+}
+
+/* Load 8 big-endian words from each of the 16 lanes, word-major */
+MB_TARGET
+static void load_words(__m512i *out, const unsigned char *const *data,
+                       size_t offset)
+{
+    const __m256i bswap = _mm256_set_epi8(
+        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    __m256i lo[8], hi[8];
+    int i;
+
+    transpose8(lo, data, offset);
+    transpose8(hi, data + 8, offset);
+
+    for (i = 0; i < 8; i++) {
+        __m256i x = _mm256_shuffle_epi8(lo[i], bswap);
+        __m256i y = _mm256_shuffle_epi8(hi[i], bswap);
+
+        out[i] = _mm512_inserti64x4(_mm512_castsi256_si512(x), y, 1);
+    }
+}
+
+MB_TARGET
+void sha256_transf_x16_avx512(uint32 *state, const unsigned char *const *data,
+                              size_t block_nb)
+{
+    __m512i a, b, c, d, e, f, g, h, t1, t2;
+    __m512i w[16];
+    size_t i;
+
+    for (i = 0; i < block_nb; i++) {
+        size_t offset = i * MYC_SHA256_BLOCK_SIZE;
+
+        load_words(&w[0], data, offset);
+        load_words(&w[8], data, offset + 32);
+
+        a = _mm512_loadu_si512(&state[0 * 16]);
+        b = _mm512_loadu_si512(&state[1 * 16]);
+        c = _mm512_loadu_si512(&state[2 * 16]);
+        d = _mm512_loadu_si512(&state[3 * 16]);
+        e = _mm512_loadu_si512(&state[4 * 16]);
+        f = _mm512_loadu_si512(&state[5 * 16]);
+        g = _mm512_loadu_si512(&state[6 * 16]);
+        h = _mm512_loadu_si512(&state[7 * 16]);
+
+        ROUND8( 0); ROUND8( 8);
+        SCHED8(16); ROUND8(16); SCHED8(24); ROUND8(24);
+        SCHED8(32); ROUND8(32); SCHED8(40); ROUND8(40);
+        SCHED8(48); ROUND8(48); SCHED8(56); ROUND8(56);
+
+#define STORE_ADD(i, x)                                                 \
+        _mm512_storeu_si512(&state[(i) * 16],                           \
+                            ADD(x, _mm512_loadu_si512(&state[(i) * 16])))
+
+        STORE_ADD(0, a); STORE_ADD(1, b); STORE_ADD(2, c); STORE_ADD(3, d);
+        STORE_ADD(4, e); STORE_ADD(5, f); STORE_ADD(6, g); STORE_ADD(7, h);
+
+#undef STORE_ADD
+    }
+}
+
+#endif /* MYC_X86 */
@@ -0,0 +1,99 @@
+/*
+ * 2-lane SHA-224/256 block transform (portable)
+ *
+ * Two independent message streams are hashed in general purpose
+ * registers, each round and schedule step of one stream being followed
+ * by the same one of the other stream, so that a superscalar core runs
+ * both dependency chains side by side. This is the multi-buffer engine
+ * of CPUs without SIMD units. The state is word-major as for the SIMD
+ * transforms: state[i * 2 + l] is word i of lane l.
+ */
+
+#include "dispatch.h"
+
+#define ROTR(x, n)   (((x) >> (n)) | ((x) << (32 - (n))))
+#define CH(x, y, z)  (((x) & (y)) ^ (~(x) & (z)))
+#define MAJ(x, y, z) (((x) & (y)) | ((z) & ((x) | (y))))
+
+#define S0(x) (ROTR(x,  2) ^ ROTR(x, 13) ^ ROTR(x, 22))
+#define S1(x) (ROTR(x,  6) ^ ROTR(x, 11) ^ ROTR(x, 25))
+#define s0(x) (ROTR(x,  7) ^ ROTR(x, 18) ^ ((x) >>  3))
+#define s1(x) (ROTR(x, 17) ^ ROTR(x, 19) ^ ((x) >> 10))
+
+#define PACK32(b, i)                                                    \
+    (  ((uint32) (b)[(i)    ] << 24) | ((uint32) (b)[(i) + 1] << 16)    \
+     | ((uint32) (b)[(i) + 2] <<  8) |  (uint32) (b)[(i) + 3]       )
+
+/* Message schedule word t >= 16 of lane l, in a circular buffer */
+#define SCHED1(w, t)                                                    \
+    w[(t) & 15] += s0(w[((t) - 15) & 15]) + w[((t) - 7) & 15]           \
+                   + s1(w[((t) - 2) & 15])
+
+#define ROUND1(a, b, c, d, e, f, g, h, w, t)                            \
+{                                                                       \
+    uint32 t1 = h + S1(e) + CH(e, f, g) + sha256_k[t] + w[(t) & 15];    \
+    uint32 t2 = S0(a) + MAJ(a, b, c);                                   \
+    d += t1;                                                            \
+    h = t1 + t2;                                                        \
+}
+
+/* Round t of both lanes, scheduling its word first from t = 16 on */
+#define ROUND(a, b, c, d, e, f, g, h, t)                                \
+{                                                                       \
+    if ((t) >= 16) {                                                    \
+        SCHED1(w0, t);                                                  \
+        SCHED1(w1, t);                                                  \
+    }                                                                   \
+    ROUND1(a##0, b##0, c##0, d##0, e##0, f##0, g##0, h##0, w0, t);      \
+    ROUND1(a##1, b##1, c##1, d##1, e##1, f##1, g##1, h##1, w1, t);      \
+}
+
+#define ROUND8(t)                                                       \
+{                                                                       \
+    ROUND(a, b, c, d, e, f, g, h, (t) + 0);                             \
+    ROUND(h, a, b, c, d, e, f, g, (t) + 1);                             \
+    ROUND(g, h, a, b, c, d, e, f, (t) + 2);                             \
+    ROUND(f, g, h, a, b, c, d, e, (t) + 3);                             \
+    ROUND(e, f, g, h, a, b, c, d, (t) + 4);                             \
+    ROUND(d, e, f, g, h, a, b, c, (t) + 5);                             \
+    ROUND(c, d, e, f, g, h, a, b, (t) + 6);                             \
+    ROUND(b, c, d, e, f, g, h, a, (t) + 7);                             \
+}
+
+void sha256_transf_x2_c(uint32 *state, const unsigned char *const *data,
+                        size_t block_nb)
+{
+    uint32 a0, b0, c0, d0, e0, f0, g0, h0;
+    uint32 a1, b1, c1, d1, e1, f1, g1, h1;
+    uint32 w0[16], w1[16];
+    size_t i;
+    int j;
+
+    for (i = 0; i < block_nb; i++) {
+        const unsigned char *p0 = data[0] + i * MYC_SHA256_BLOCK_SIZE;
+        const unsigned char *p1 = data[1] + i * MYC_SHA256_BLOCK_SIZE;
+
+        for (j = 0; j < 16; j++) {
+            w0[j] = PACK32(p0, j * 4);
+            w1[j] = PACK32(p1, j * 4);
+        }
+
+        a0 = state[0 * 2]; b0 = state[1 * 2]; c0 = state[2 * 2];
+        d0 = state[3 * 2]; e0 = state[4 * 2]; f0 = state[5 * 2];
+        g0 = state[6 * 2]; h0 = state[7 * 2];
+        a1 = state[0 * 2 + 1]; b1 = state[1 * 2 + 1]; c1 = state[2 * 2 + 1];
+        d1 = state[3 * 2 + 1]; e1 = state[4 * 2 + 1]; f1 = state[5 * 2 + 1];
+        g1 = state[6 * 2 + 1]; h1 = state[7 * 2 + 1];
+
+        ROUND8( 0); ROUND8( 8); ROUND8(16); ROUND8(24);
+        ROUND8(32); ROUND8(40); ROUND8(48); ROUND8(56);
+
+        state[0 * 2] += a0; state[1 * 2] += b0; state[2 * 2] += c0;
+        state[3 * 2] += d0; state[4 * 2] += e0; state[5 * 2] += f0;
+        state[6 * 2] += g0; state[7 * 2] += h0;
+        state[0 * 2 + 1] += a1; state[1 * 2 + 1] += b1;
+        state[2 * 2 + 1] += c1; state[3 * 2 + 1] += d1;
+        state[4 * 2 + 1] += e1; state[5 * 2 + 1] += f1;
+        state[6 * 2 + 1] += g1; state[7 * 2 + 1] += h1;
+    }
+}
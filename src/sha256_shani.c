@@ -0,0 +1,103 @@
+/*
+ * SHA-224/256 block transform using the Intel SHA extensions
+ *
+ * The chaining state is kept in two registers in the ABEF/CDGH order
+ * expected by SHA256RNDS2, each instruction performing two rounds.
+ * The message schedule is computed four words at a time with
+ * SHA256MSG1/SHA256MSG2.
+ */
+
+#include "dispatch.h"
+
+#ifdef MYC_X86
+
+#include <immintrin.h>
+
+#define SHANI_TARGET __attribute__((target("sha,sse4.1")))
+
+/* Four rounds j..j+3, w holds the scheduled words W[j..j+3] */
+#define SHANI_ROUNDS(w, j)                                              \
+{                                                                       \
+    msg = _mm_add_epi32(w,                                              \
+              _mm_loadu_si128((const __m128i *) &sha256_k[j]));         \
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);                \
+    msg = _mm_shuffle_epi32(msg, 0x0E);                                 \
+    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);                \
+}
+
+/* Finish W[j+4..j+7] into w0 from the two preceding groups w2, w3 */
+#define SHANI_SCHED2(w0, w2, w3)                                        \
+{                                                                       \
+    tmp = _mm_alignr_epi8(w3, w2, 4);                                   \
+    w0 = _mm_add_epi32(w0, tmp);                                        \
+    w0 = _mm_sha256msg2_epu32(w0, w3);                                  \
+}
+
+#define SHANI_SCHED1(w0, w1)                                            \
+{                                                                       \
+    w0 = _mm_sha256msg1_epu32(w0, w1);                                  \
+}
+
+SHANI_TARGET
+void sha256_transf_shani(uint32 *h, const unsigned char *message,
+                         size_t block_nb)
+{
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+                                         0x0405060700010203ULL);
+    __m128i state0, state1, save0, save1;
+    __m128i msg, tmp, w0, w1, w2, w3;
+
+    tmp = _mm_loadu_si128((const __m128i *) &h[0]);
+    state1 = _mm_loadu_si128((const __m128i *) &h[4]);
+
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);            /* CDAB */
+    state1 = _mm_shuffle_epi32(state1, 0x1B);      /* EFGH */
+    state0 = _mm_alignr_epi8(tmp, state1, 8);      /* ABEF */
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);   /* CDGH */
+
+    while (block_nb--) {
+        save0 = state0;
+        save1 = state1;
+
+        w0 = _mm_shuffle_epi8(
+                 _mm_loadu_si128((const __m128i *) (message +  0)), bswap);
+        w1 = _mm_shuffle_epi8(
+                 _mm_loadu_si128((const __m128i *) (message + 16)), bswap);
+        w2 = _mm_shuffle_epi8(
+                 _mm_loadu_si128((const __m128i *) (message + 32)), bswap);
+        w3 = _mm_shuffle_epi8(
+                 _mm_loadu_si128((const __m128i *) (message + 48)), bswap);
+
+        SHANI_ROUNDS(w0,  0);
+        SHANI_ROUNDS(w1,  4); SHANI_SCHED1(w0, w1);
+        SHANI_ROUNDS(w2,  8); SHANI_SCHED1(w1, w2);
+        SHANI_ROUNDS(w3, 12); SHANI_SCHED2(w0, w2, w3); SHANI_SCHED1(w2, w3);
+        SHANI_ROUNDS(w0, 16); SHANI_SCHED2(w1, w3, w0); SHANI_SCHED1(w3, w0);
+        SHANI_ROUNDS(w1, 20); SHANI_SCHED2(w2, w0, w1); SHANI_SCHED1(w0, w1);
+        SHANI_ROUNDS(w2, 24); SHANI_SCHED2(w3, w1, w2); SHANI_SCHED1(w1, w2);
+        SHANI_ROUNDS(w3, 28); SHANI_SCHED2(w0, w2, w3); SHANI_SCHED1(w2, w3);
+        SHANI_ROUNDS(w0, 32); SHANI_SCHED2(w1, w3, w0); SHANI_SCHED1(w3, w0);
+        SHANI_ROUNDS(w1, 36); SHANI_SCHED2(w2, w0, w1); SHANI_SCHED1(w0, w1);
+        SHANI_ROUNDS(w2, 40); SHANI_SCHED2(w3, w1, w2); SHANI_SCHED1(w1, w2);
+        SHANI_ROUNDS(w3, 44); SHANI_SCHED2(w0, w2, w3); SHANI_SCHED1(w2, w3);
+        SHANI_ROUNDS(w0, 48); SHANI_SCHED2(w1, w3, w0); SHANI_SCHED1(w3, w0);
+        SHANI_ROUNDS(w1, 52); SHANI_SCHED2(w2, w0, w1);
+        SHANI_ROUNDS(w2, 56); SHANI_SCHED2(w3, w1, w2);
+        SHANI_ROUNDS(w3, 60);
+
+        state0 = _mm_add_epi32(state0, save0);
+        state1 = _mm_add_epi32(state1, save1);
+
+        message += MYC_SHA256_BLOCK_SIZE;
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);         /* FEBA */
+    state1 = _mm_shuffle_epi32(state1, 0xB1);      /* DCHG */
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);   /* DCBA */
+    state1 = _mm_alignr_epi8(state1, tmp, 8);      /* HGFE */
+
+    _mm_storeu_si128((__m128i *) &h[0], state0);
+    _mm_storeu_si128((__m128i *) &h[4], state1);
+}
+
+#endif /* MYC_X86 */
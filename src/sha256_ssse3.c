@@ -0,0 +1,144 @@
+/*
+ * SHA-224/256 block transform with a SIMD message schedule (SSSE3/AVX)
+ *
+ * The rounds are computed on general purpose registers while the
+ * message schedule is computed four words at a time in an xmm register,
+ * each group of four rounds being interleaved with the schedule of the
+ * words needed sixteen rounds later. Scheduled words are stored with
+ * their round constant added in a 16-entry circular buffer. The same
+ * code is compiled twice, the AVX version only differing by its
+ * three-operand VEX encoding.
+ */
+
+#include "dispatch.h"
+
+#ifdef MYC_X86
+
+#include <immintrin.h>
+
+#define SSSE3_TARGET __attribute__((target("ssse3")))
+#define AVX_TARGET   __attribute__((target("avx")))
+
+#define ROTR(x, n)   ((x >> n) | (x << (32 - n)))
+#define CH(x, y, z)  ((x & y) ^ (~x & z))
+#define MAJ(x, y, z) ((x & y) | (z & (x | y)))
+
+#define S0(x) (ROTR(x,  2) ^ ROTR(x, 13) ^ ROTR(x, 22))
+#define S1(x) (ROTR(x,  6) ^ ROTR(x, 11) ^ ROTR(x, 25))
+
+#define ROUND(a, b, c, d, e, f, g, h, wk)                               \
+{                                                                       \
+    t1 = h + S1(e) + CH(e, f, g) + (wk);                                \
+    t2 = S0(a) + MAJ(a, b, c);                                          \
+    d += t1;                                                            \
+    h = t1 + t2;                                                        \
+}
+
+/* Rounds j..j+3, after which the roles of a..h move by four */
+#define ROUND4(a, b, c, d, e, f, g, h, j)                               \
+{                                                                       \
+    ROUND(a, b, c, d, e, f, g, h, wk[((j) + 0) & 15]);                  \
+    ROUND(h, a, b, c, d, e, f, g, wk[((j) + 1) & 15]);                  \
+    ROUND(g, h, a, b, c, d, e, f, wk[((j) + 2) & 15]);                  \
+    ROUND(f, g, h, a, b, c, d, e, wk[((j) + 3) & 15]);                  \
+}
+
+#define XROTR(x, n) _mm_or_si128(_mm_srli_epi32(x, n),                  \
+                                 _mm_slli_epi32(x, 32 - (n)))
+
+/*
+ * sigma1 of the words in lanes 0 and 2 of x, lanes 1 and 3 holding a
+ * copy of them, returned in lanes 0 and 1. The 64-bit shifts of a
+ * duplicated word give its 32-bit rotations in the low half.
+ */
+#define XSIGMA1_2(x)                                                    \
+    _mm_shuffle_epi32(_mm_xor_si128(_mm_xor_si128(                      \
+        _mm_srli_epi32(x, 10), _mm_srli_epi64(x, 17)),                  \
+        _mm_srli_epi64(x, 19)), 0x08)
+
+/*
+ * W[t..t+3] into x0, which holds W[t-16..t-13] and x1..x3 the next
+ * words up to W[t-1]. sigma1 needs W[t-2..t+1], so the two high words
+ * are finished after the two low ones.
+ */
+#define XSCHED(x0, x1, x2, x3)                                          \
+{                                                                       \
+    w15 = _mm_alignr_epi8(x1, x0, 4);                                   \
+    w7 = _mm_alignr_epi8(x3, x2, 4);                                    \
+    x0 = _mm_add_epi32(_mm_add_epi32(x0, w7),                           \
+             _mm_xor_si128(_mm_xor_si128(XROTR(w15, 7), XROTR(w15, 18)),\
+                           _mm_srli_epi32(w15, 3)));                    \
+    tmp = _mm_shuffle_epi32(x3, 0xFA);                                  \
+    x0 = _mm_add_epi32(x0, _mm_move_epi64(XSIGMA1_2(tmp)));             \
+    tmp = _mm_shuffle_epi32(x0, 0x50);                                  \
+    x0 = _mm_add_epi32(x0, _mm_slli_si128(XSIGMA1_2(tmp), 8));          \
+}
+
+#define XSTORE_WK(x, j)                                                 \
+    _mm_store_si128((__m128i *) &wk[(j) & 15], _mm_add_epi32(x,         \
+        _mm_loadu_si128((const __m128i *) &sha256_k[j])))
+
+/* Rounds j..j+3 while scheduling W[j+16..j+19] */
+#define SCHED_ROUND4(x0, x1, x2, x3, a, b, c, d, e, f, g, h, j)         \
+{                                                                       \
+    XSCHED(x0, x1, x2, x3);                                             \
+    ROUND4(a, b, c, d, e, f, g, h, j);                                  \
+    XSTORE_WK(x0, (j) + 16);                                            \
+}
+
+#define XLOAD(x, offset)                                                \
+    x = _mm_shuffle_epi8(_mm_loadu_si128(                               \
+            (const __m128i *) (message + (offset))), bswap)
+
+SSSE3_TARGET __attribute__((always_inline))
+static inline void sha256_transf_xmm(uint32 *h, const unsigned char *message,
+                                     size_t block_nb)
+{
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+                                         0x0405060700010203ULL);
+    uint32 wk[16] __attribute__((aligned(16)));
+    uint32 a, b, c, d, e, f, g, hh, t1, t2;
+    __m128i x0, x1, x2, x3, w15, w7, tmp;
+    int j;
+
+    a = h[0]; b = h[1]; c = h[2]; d = h[3];
+    e = h[4]; f = h[5]; g = h[6]; hh = h[7];
+
+    while (block_nb--) {
+        XLOAD(x0,  0); XLOAD(x1, 16); XLOAD(x2, 32); XLOAD(x3, 48);
+        XSTORE_WK(x0, 0); XSTORE_WK(x1, 4);
+        XSTORE_WK(x2, 8); XSTORE_WK(x3, 12);
+
+        for (j = 0; j < 48; j += 16) {
+            SCHED_ROUND4(x0, x1, x2, x3, a, b, c, d, e, f, g, hh, j +  0);
+            SCHED_ROUND4(x1, x2, x3, x0, e, f, g, hh, a, b, c, d, j +  4);
+            SCHED_ROUND4(x2, x3, x0, x1, a, b, c, d, e, f, g, hh, j +  8);
+            SCHED_ROUND4(x3, x0, x1, x2, e, f, g, hh, a, b, c, d, j + 12);
+        }
+        ROUND4(a, b, c, d, e, f, g, hh, 48);
+        ROUND4(e, f, g, hh, a, b, c, d, 52);
+        ROUND4(a, b, c, d, e, f, g, hh, 56);
+        ROUND4(e, f, g, hh, a, b, c, d, 60);
+
+        a = h[0] += a; b = h[1] += b; c = h[2] += c; d = h[3] += d;
+        e = h[4] += e; f = h[5] += f; g = h[6] += g; hh = h[7] += hh;
+
+        message += MYC_SHA256_BLOCK_SIZE;
+    }
+}
+
+SSSE3_TARGET
+void sha256_transf_ssse3(uint32 *h, const unsigned char *message,
+                         size_t block_nb)
+{
+    sha256_transf_xmm(h, message, block_nb);
+}
+
+AVX_TARGET
+void sha256_transf_avx(uint32 *h, const unsigned char *message,
+                       size_t block_nb)
+{
+    sha256_transf_xmm(h, message, block_nb);
+}
+
+#endif /* MYC_X86 */
@@ -0,0 +1,254 @@
+/*
+ * SHA-2 hashing of many independent messages
+ *
+ * Every lane of the multi-buffer transform first runs over the full
+ * blocks of its message in place, then over one or two padded final
+ * blocks prepared in a lane buffer. As soon as a lane is done with its
+ * message it starts on the next message of the batch, so that lanes
+ * only go idle at the end of the batch. Lanes without work in a call
+ * reuse the input of an active lane and their result is ignored.
+ */
+
+#include <string.h>
+
+#include "dispatch.h"
+#include "md_lane.h"
+
+#define SHA2_MAX_LANES 16
+
+/* SHA-224/256 */
+
+static void sha256_store(const uint32 *state, unsigned int stride,
+                         unsigned char *digest, unsigned int digest_size)
+{
+    unsigned int i;
+
+    for (i = 0; i < digest_size / 4; i++) {
+        uint32 x = state[i * stride];
+
+        digest[i * 4 + 0] = (unsigned char) (x >> 24);
+        digest[i * 4 + 1] = (unsigned char) (x >> 16);
+        digest[i * 4 + 2] = (unsigned char) (x >>  8);
+        digest[i * 4 + 3] = (unsigned char) (x      );
+    }
+}
+
+static void sha256_batch_serial(const uint32 *h0,
+                                const unsigned char **messages,
+                                const size_t *lens, size_t count,
+                                unsigned char *digests,
+                                unsigned int digest_size)
+{
+    md_lane lane;
+    uint32 h[8];
+    size_t n;
+
+    for (n = 0; n < count; n++) {
+        memcpy(h, h0, sizeof(h));
+        md_lane_init(&lane, messages[n], lens[n],
+                     MYC_SHA256_BLOCK_SIZE, 0);
+        do {
+            myc_dispatch.sha256_transf(h, lane.data, lane.block_nb);
+        } while (md_lane_advance(&lane, lane.block_nb,
+                                 MYC_SHA256_BLOCK_SIZE));
+        sha256_store(h, 1, digests + n * digest_size, digest_size);
+    }
+}
+
+static void sha256_batch(const uint32 *h0, const unsigned char **messages,
+                         const size_t *lens, size_t count,
+                         unsigned char *digests, unsigned int digest_size)
+{
+    md_lane lanes[SHA2_MAX_LANES];
+    const unsigned char *data[SHA2_MAX_LANES];
+    sha256_mb_impl mb;
+    uint32 state[8 * SHA2_MAX_LANES];
+    size_t msg[SHA2_MAX_LANES];
+    int active[SHA2_MAX_LANES];
+    unsigned int lane_nb, left, l, i;
+    size_t next;
+
+    myc_dispatch_init();
+    mb = myc_dispatch.sha256_mb[MYC_BATCH_CLASS(count)];
+    lane_nb = mb.lanes;
+    if (mb.fn == NULL || lane_nb > SHA2_MAX_LANES) {
+        sha256_batch_serial(h0, messages, lens, count, digests, digest_size);
+        return;
+    }
+
+    next = 0;
+    left = 0;
+    for (l = 0; l < lane_nb; l++) {
+        active[l] = next < count;
+        if (active[l]) {
+            msg[l] = next++;
+            md_lane_init(&lanes[l], messages[msg[l]], lens[msg[l]],
+                         MYC_SHA256_BLOCK_SIZE, 0);
+            left++;
+        }
+        for (i = 0; i < 8; i++) {
+            state[i * lane_nb + l] = h0[i];
+        }
+    }
+
+    while (left > 0) {
+        size_t block_nb = md_lanes_next(lanes, active, lane_nb, data);
+
+        mb.fn(state, data, block_nb);
+
+        for (l = 0; l < lane_nb; l++) {
+            if (!active[l] || md_lane_advance(&lanes[l], block_nb,
+                                              MYC_SHA256_BLOCK_SIZE))
+                continue;
+
+            sha256_store(&state[l], lane_nb, digests + msg[l] * digest_size,
+                         digest_size);
+            if (next == count) {
+                active[l] = 0;
+                left--;
+                continue;
+            }
+
+            /* refill the lane with the next message */
+            msg[l] = next++;
+            md_lane_init(&lanes[l], messages[msg[l]], lens[msg[l]],
+                         MYC_SHA256_BLOCK_SIZE, 0);
+            for (i = 0; i < 8; i++) {
+                state[i * lane_nb + l] = h0[i];
+            }
+        }
+    }
+}
+
+void myc_sha256_batch(const unsigned char **messages, const size_t *lens,
+                      size_t count, unsigned char *digests)
+{
+    sha256_batch(sha256_h0, messages, lens, count, digests,
+                 MYC_SHA256_DIGEST_SIZE);
+}
+
+void myc_sha224_batch(const unsigned char **messages, const size_t *lens,
+                      size_t count, unsigned char *digests)
+{
+    sha256_batch(sha224_h0, messages, lens, count, digests,
+                 MYC_SHA224_DIGEST_SIZE);
+}
+
+/* SHA-384/512 */
+
+static void sha512_store(const uint64 *state, unsigned int stride,
+                         unsigned char *digest, unsigned int digest_size)
+{
+    unsigned int i;
+    int j;
+
+    for (i = 0; i < digest_size / 8; i++) {
+        uint64 x = state[i * stride];
+
+        for (j = 7; j >= 0; j--) {
+            digest[i * 8 + j] = (unsigned char) x;
+            x >>= 8;
+        }
+    }
+}
+
+static void sha512_batch_serial(const uint64 *h0,
+                                const unsigned char **messages,
+                                const size_t *lens, size_t count,
+                                unsigned char *digests,
+                                unsigned int digest_size)
+{
+    md_lane lane;
+    uint64 h[8];
+    size_t n;
+
+    for (n = 0; n < count; n++) {
+        memcpy(h, h0, sizeof(h));
+        md_lane_init(&lane, messages[n], lens[n],
+                     MYC_SHA512_BLOCK_SIZE, 0);
+        do {
+            myc_dispatch.sha512_transf(h, lane.data, lane.block_nb);
+        } while (md_lane_advance(&lane, lane.block_nb,
+                                 MYC_SHA512_BLOCK_SIZE));
+        sha512_store(h, 1, digests + n * digest_size, digest_size);
+    }
+}
+
+static void sha512_batch(const uint64 *h0, const unsigned char **messages,
+                         const size_t *lens, size_t count,
+                         unsigned char *digests, unsigned int digest_size)
+{
+    md_lane lanes[SHA2_MAX_LANES];
+    const unsigned char *data[SHA2_MAX_LANES];
+    sha512_mb_impl mb;
+    uint64 state[8 * SHA2_MAX_LANES];
+    size_t msg[SHA2_MAX_LANES];
+    int active[SHA2_MAX_LANES];
+    unsigned int lane_nb, left, l, i;
+    size_t next;
+
+    myc_dispatch_init();
+    mb = myc_dispatch.sha512_mb[MYC_BATCH_CLASS(count)];
+    lane_nb = mb.lanes;
+    if (mb.fn == NULL || lane_nb > SHA2_MAX_LANES) {
+        sha512_batch_serial(h0, messages, lens, count, digests, digest_size);
+        return;
+    }
+
+    next = 0;
+    left = 0;
+    for (l = 0; l < lane_nb; l++) {
+        active[l] = next < count;
+        if (active[l]) {
+            msg[l] = next++;
+            md_lane_init(&lanes[l], messages[msg[l]], lens[msg[l]],
+                         MYC_SHA512_BLOCK_SIZE, 0);
+            left++;
+        }
+        for (i = 0; i < 8; i++) {
+            state[i * lane_nb + l] = h0[i];
+        }
+    }
+
+    while (left > 0) {
+        size_t block_nb = md_lanes_next(lanes, active, lane_nb, data);
+
+        mb.fn(state, data, block_nb);
+
+        for (l = 0; l < lane_nb; l++) {
+            if (!active[l] || md_lane_advance(&lanes[l], block_nb,
+                                              MYC_SHA512_BLOCK_SIZE))
+                continue;
+
+            sha512_store(&state[l], lane_nb, digests + msg[l] * digest_size,
+                         digest_size);
+            if (next == count) {
+                active[l] = 0;
+                left--;
+                continue;
+            }
+
+            /* refill the lane with the next message */
+            msg[l] = next++;
+            md_lane_init(&lanes[l], messages[msg[l]], lens[msg[l]],
+                         MYC_SHA512_BLOCK_SIZE, 0);
+            for (i = 0; i < 8; i++) {
+                state[i * lane_nb + l] = h0[i];
+            }
+        }
+    }
+}
+
+void myc_sha512_batch(const unsigned char **messages, const size_t *lens,
+                      size_t count, unsigned char *digests)
+{
+    sha512_batch(sha512_h0, messages, lens, count, digests,
+                 MYC_SHA512_DIGEST_SIZE);
+}
+
+void myc_sha384_batch(const unsigned char **messages, const size_t *lens,
+                      size_t count, unsigned char *digests)
+{
+    sha512_batch(sha384_h0, messages, lens, count, digests,
+                 MYC_SHA384_DIGEST_SIZE);
+}
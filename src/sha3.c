@@ -19,13 +19,14 @@
 
 #include <assert.h>
 #include <string.h>
+#include <sys/uio.h>
 
-#include "sha3.h"
+#include "dispatch.h"
+#include "keccak_round.h"
 
 #define I64(x) x##LL
 #define ROTL64(qword, n) ((qword) << (n) ^ ((qword) >> (64 - (n))))
 #define le2me_64(x) (x)
-#define IS_ALIGNED_64(p) (0 == (7 & ((const char *)(p) - (const char *)0)))
 #define me64_to_le_str(to, from, length) memcpy((to), (from), (length))
 #define MEMSET_BZERO(p,l)	memset((p), 0, (l))
 
@@ -33,7 +34,7 @@
 #define NumberOfRounds 24
 
 /* SHA3 (Keccak) constants for 24 rounds */
-static uint64_t myc_keccak_round_constants[NumberOfRounds] = {
+uint64_t myc_keccak_round_constants[NumberOfRounds] = {
     I64(0x0000000000000001), I64(0x0000000000008082), I64(0x800000000000808A),
     I64(0x8000000080008000), I64(0x000000000000808B), I64(0x0000000080000001),
     I64(0x8000000080008081), I64(0x8000000000008009), I64(0x000000000000008A),
@@ -94,171 +95,212 @@ void myc_sha3_512_Init(MYC_SHA3_CTX *ctx)
     myc_keccak_Init(ctx, 512);
 }
 
-/* Keccak theta() transformation */
-static void myc_keccak_theta(uint64_t *A)
+/**
+ * Initialize a SHAKE128 context before absorbing the message.
+ *
+ * @param ctx context to initialize
+ */
+void myc_shake128_Init(MYC_SHA3_CTX *ctx)
 {
-    unsigned int x;
-    uint64_t C[5], D[5];
+    myc_keccak_Init(ctx, 128);
+}
 
-    for (x = 0; x < 5; x++) {
-        C[x] = A[x] ^ A[x + 5] ^ A[x + 10] ^ A[x + 15] ^ A[x + 20];
-    }
-    D[0] = ROTL64(C[1], 1) ^ C[4];
-    D[1] = ROTL64(C[2], 1) ^ C[0];
-    D[2] = ROTL64(C[3], 1) ^ C[1];
-    D[3] = ROTL64(C[4], 1) ^ C[2];
-    D[4] = ROTL64(C[0], 1) ^ C[3];
-
-    for (x = 0; x < 5; x++) {
-        A[x] ^= D[x];
-        A[x + 5] ^= D[x];
-        A[x + 10] ^= D[x];
-        A[x + 15] ^= D[x];
-        A[x + 20] ^= D[x];
-    }
+/**
+ * Initialize a SHAKE256 context before absorbing the message.
+ *
+ * @param ctx context to initialize
+ */
+void myc_shake256_Init(MYC_SHA3_CTX *ctx)
+{
+    myc_keccak_Init(ctx, 256);
 }
 
-/* Keccak pi() transformation */
-static void myc_keccak_pi(uint64_t *A)
+#define KECCAK_XOR(x, y)            ((x) ^ (y))
+#define KECCAK_XOR5(a, b, c, d, e)  ((a) ^ (b) ^ (c) ^ (d) ^ (e))
+#define KECCAK_ROL(x, n)            ROTL64(x, n)
+#define KECCAK_CHI(x, y, z)         ((x) ^ (~(y) & (z)))
+
+#define KECCAK_LOAD(lane, i)  lane = state[i]
+#define KECCAK_STORE(lane, i) state[i] = lane
+
+/*
+ * The whole permutation with the 25 lanes in local variables, two
+ * rounds per iteration so that the lanes go from A.. to E.. and back
+ * without any copy.
+ */
+#define KECCAK_PERMUTATION(state)                                       \
+{                                                                       \
+    KECCAK_LANES(uint64_t, A);                                          \
+    KECCAK_LANES(uint64_t, E);                                          \
+    KECCAK_TEMPS(uint64_t);                                             \
+    int round;                                                          \
+                                                                        \
+    KECCAK_MAP(A, KECCAK_LOAD);                                         \
+    for (round = 0; round < NumberOfRounds; round += 2) {               \
+        KECCAK_ROUND(A, E, myc_keccak_round_constants[round]);          \
+        KECCAK_ROUND(E, A, myc_keccak_round_constants[round + 1]);      \
+    }                                                                   \
+    KECCAK_MAP(A, KECCAK_STORE);                                        \
+}
+
+void myc_sha3_permutation_c(uint64_t *state)
 {
-    uint64_t A1;
-    A1 = A[1];
-    A[1] = A[6];
-    A[6] = A[9];
-    A[9] = A[22];
-    A[22] = A[14];
-    A[14] = A[20];
-    A[20] = A[2];
-    A[2] = A[12];
-    A[12] = A[13];
-    A[13] = A[19];
-    A[19] = A[23];
-    A[23] = A[15];
-    A[15] = A[4];
-    A[4] = A[24];
-    A[24] = A[21];
-    A[21] = A[8];
-    A[8] = A[16];
-    A[16] = A[5];
-    A[5] = A[3];
-    A[3] = A[18];
-    A[18] = A[17];
-    A[17] = A[11];
-    A[11] = A[7];
-    A[7] = A[10];
-    A[10] = A1;
-    /* note: A[ 0] is left as is */
-}
-
-/* Keccak chi() transformation */
-static void myc_keccak_chi(uint64_t *A)
+    KECCAK_PERMUTATION(state);
+}
+
+#ifdef MYC_X86
+/* Same code where the compiler may use ANDN in chi */
+__attribute__((target("bmi")))
+void myc_sha3_permutation_bmi1(uint64_t *state)
 {
-    int i;
-    for (i = 0; i < 25; i += 5) {
-        uint64_t A0 = A[0 + i], A1 = A[1 + i];
-        A[0 + i] ^= ~A1 & A[2 + i];
-        A[1 + i] ^= ~A[2 + i] & A[3 + i];
-        A[2 + i] ^= ~A[3 + i] & A[4 + i];
-        A[3 + i] ^= ~A[4 + i] & A0;
-        A[4 + i] ^= ~A0 & A1;
-    }
+    KECCAK_PERMUTATION(state);
 }
+#endif
 
-static void myc_sha3_permutation(uint64_t *state)
+/* Load a little-endian lane at any alignment */
+static uint64_t myc_sha3_load64(const unsigned char *p)
 {
-    int round;
-    for (round = 0; round < NumberOfRounds; round++) {
-        myc_keccak_theta(state);
-
-        /* apply Keccak rho() transformation */
-        state[1] = ROTL64(state[1], 1);
-        state[2] = ROTL64(state[2], 62);
-        state[3] = ROTL64(state[3], 28);
-        state[4] = ROTL64(state[4], 27);
-        state[5] = ROTL64(state[5], 36);
-        state[6] = ROTL64(state[6], 44);
-        state[7] = ROTL64(state[7], 6);
-        state[8] = ROTL64(state[8], 55);
-        state[9] = ROTL64(state[9], 20);
-        state[10] = ROTL64(state[10], 3);
-        state[11] = ROTL64(state[11], 10);
-        state[12] = ROTL64(state[12], 43);
-        state[13] = ROTL64(state[13], 25);
-        state[14] = ROTL64(state[14], 39);
-        state[15] = ROTL64(state[15], 41);
-        state[16] = ROTL64(state[16], 45);
-        state[17] = ROTL64(state[17], 15);
-        state[18] = ROTL64(state[18], 21);
-        state[19] = ROTL64(state[19], 8);
-        state[20] = ROTL64(state[20], 18);
-        state[21] = ROTL64(state[21], 2);
-        state[22] = ROTL64(state[22], 61);
-        state[23] = ROTL64(state[23], 56);
-        state[24] = ROTL64(state[24], 14);
-
-        myc_keccak_pi(state);
-        myc_keccak_chi(state);
-
-        /* apply iota(state, round) */
-        *state ^= myc_keccak_round_constants[round];
+    uint64_t w;
+
+    memcpy(&w, p, sizeof(w));
+    return le2me_64(w);
+}
+
+#define SHA3_XOR(i) hash[i] ^= myc_sha3_load64(msg + (i) * 8)
+
+/* Expanded xor of a block into the state, one list per rate in bytes */
+#define SHA3_XOR_72                                                     \
+    SHA3_XOR(0); SHA3_XOR(1); SHA3_XOR(2); SHA3_XOR(3); SHA3_XOR(4);    \
+    SHA3_XOR(5); SHA3_XOR(6); SHA3_XOR(7); SHA3_XOR(8)
+#define SHA3_XOR_104                                                    \
+    SHA3_XOR_72;                                                        \
+    SHA3_XOR(9); SHA3_XOR(10); SHA3_XOR(11); SHA3_XOR(12)
+#define SHA3_XOR_136                                                    \
+    SHA3_XOR_104;                                                       \
+    SHA3_XOR(13); SHA3_XOR(14); SHA3_XOR(15); SHA3_XOR(16)
+#define SHA3_XOR_144                                                    \
+    SHA3_XOR_136;                                                       \
+    SHA3_XOR(17)
+#define SHA3_XOR_168                                                    \
+    SHA3_XOR_144;                                                       \
+    SHA3_XOR(18); SHA3_XOR(19); SHA3_XOR(20)
+
+/*
+ * Absorb block_nb full blocks for one rate. Each instance has its own
+ * constant block size, so no branch depends on the rate within the
+ * loop. Blocks are read in place whatever their alignment.
+ */
+#define SHA3_ABSORB(rate)                                               \
+static void myc_sha3_absorb_##rate(uint64_t hash[25],                   \
+                                   const unsigned char *msg,            \
+                                   size_t block_nb)                     \
+{                                                                       \
+    for (; block_nb > 0; block_nb--, msg += (rate)) {                   \
+        SHA3_XOR_##rate;                                                \
+        myc_dispatch.sha3_permutation(hash);                            \
+    }                                                                   \
+}
+
+SHA3_ABSORB(72)     /* SHA3-512 */
+SHA3_ABSORB(104)    /* SHA3-384 */
+SHA3_ABSORB(136)    /* SHA3-256, SHAKE256 */
+SHA3_ABSORB(144)    /* SHA3-224 */
+SHA3_ABSORB(168)    /* SHAKE128 */
+
+/**
+ * Apply the Keccak-f[1600] permutation of the dispatched backend.
+ *
+ * @param state the 25 lanes of the state
+ */
+void myc_sha3_permute(uint64_t state[25])
+{
+    myc_dispatch.sha3_permutation(state);
+}
+
+/**
+ * The core transformation. Process the specified blocks of data with
+ * the absorb routine of the context rate.
+ *
+ * @param ctx the algorithm context
+ * @param msg the message blocks to process
+ * @param block_nb the number of blocks
+ */
+static void myc_sha3_process_blocks(MYC_SHA3_CTX *ctx,
+                                    const unsigned char *msg,
+                                    size_t block_nb)
+{
+    switch (ctx->block_size) {
+    case 72:
+        myc_sha3_absorb_72(ctx->hash, msg, block_nb);
+        break;
+    case 104:
+        myc_sha3_absorb_104(ctx->hash, msg, block_nb);
+        break;
+    case 136:
+        myc_sha3_absorb_136(ctx->hash, msg, block_nb);
+        break;
+    case 144:
+        myc_sha3_absorb_144(ctx->hash, msg, block_nb);
+        break;
+    default:
+        assert(ctx->block_size == 168);
+        myc_sha3_absorb_168(ctx->hash, msg, block_nb);
+        break;
     }
 }
 
+#define MYC_SHA3_FINALIZED 0x80000000
+
 /**
- * The core transformation. Process the specified block of data.
+ * Xor bytes of a partial block into the state, at a byte offset within
+ * the rate.
  *
  * @param hash the algorithm state
- * @param block the message block to process
- * @param block_size the size of the processed block in bytes
+ * @param offset position of the first byte in the block
+ * @param msg the bytes to absorb
+ * @param size number of bytes, offset + size is at most the rate
  */
-static void myc_sha3_process_block(uint64_t hash[25], const uint64_t *block,
-                               size_t block_size)
+static void myc_sha3_xor_bytes(uint64_t hash[25], size_t offset,
+                               const unsigned char *msg, size_t size)
 {
-    /* expanded loop */
-    hash[0] ^= le2me_64(block[0]);
-    hash[1] ^= le2me_64(block[1]);
-    hash[2] ^= le2me_64(block[2]);
-    hash[3] ^= le2me_64(block[3]);
-    hash[4] ^= le2me_64(block[4]);
-    hash[5] ^= le2me_64(block[5]);
-    hash[6] ^= le2me_64(block[6]);
-    hash[7] ^= le2me_64(block[7]);
-    hash[8] ^= le2me_64(block[8]);
-    /* if not sha3-512 */
-    if (block_size > 72) {
-        hash[9] ^= le2me_64(block[9]);
-        hash[10] ^= le2me_64(block[10]);
-        hash[11] ^= le2me_64(block[11]);
-        hash[12] ^= le2me_64(block[12]);
-        /* if not sha3-384 */
-        if (block_size > 104) {
-            hash[13] ^= le2me_64(block[13]);
-            hash[14] ^= le2me_64(block[14]);
-            hash[15] ^= le2me_64(block[15]);
-            hash[16] ^= le2me_64(block[16]);
-            /* if not sha3-256 */
-            if (block_size > 136) {
-                hash[17] ^= le2me_64(block[17]);
-#ifdef FULL_MYC_SHA3_FAMILY_SUPPORT
-                /* if not sha3-224 */
-                if (block_size > 144) {
-                    hash[18] ^= le2me_64(block[18]);
-                    hash[19] ^= le2me_64(block[19]);
-                    hash[20] ^= le2me_64(block[20]);
-                    hash[21] ^= le2me_64(block[21]);
-                    hash[22] ^= le2me_64(block[22]);
-                    hash[23] ^= le2me_64(block[23]);
-                    hash[24] ^= le2me_64(block[24]);
-                }
-#endif
-            }
+    while (size > 0) {
+        size_t shift = offset & 7;
+        size_t n = size < 8 - shift ? size : 8 - shift;
+        uint64_t w = 0;
+        size_t i;
+
+        /* a partial lane is gathered and xored as a whole lane */
+        if (n == 8) {
+            w = myc_sha3_load64(msg);
+        } else {
+            for (i = 0; i < n; i++)
+                w |= (uint64_t)msg[i] << (8 * (shift + i));
         }
+        hash[offset / 8] ^= w;
+        offset += n;
+        msg += n;
+        size -= n;
     }
-    /* make a permutation of the hash */
-    myc_sha3_permutation(hash);
 }
 
-#define MYC_SHA3_FINALIZED 0x80000000
+/**
+ * Pad the message with the domain bits and run the last permutation,
+ * once. Nothing can be absorbed afterwards.
+ *
+ * @param ctx the algorithm context
+ * @param pad 0x06 for SHA3, 0x1F for SHAKE, 0x01 for Keccak
+ */
+static void myc_sha3_finalize(MYC_SHA3_CTX *ctx, unsigned char pad)
+{
+    unsigned char *state = (unsigned char *)ctx->hash;
+
+    if (ctx->rest & MYC_SHA3_FINALIZED)
+        return;
+    state[ctx->rest] ^= pad;
+    state[ctx->block_size - 1] ^= 0x80;
+    myc_dispatch.sha3_permutation(ctx->hash);
+    ctx->rest = MYC_SHA3_FINALIZED; /* mark context as finalized */
+}
 
 /**
  * Calculate message hash.
@@ -272,41 +314,51 @@ void myc_sha3_Update(MYC_SHA3_CTX *ctx, const unsigned char *msg, size_t size)
 {
     size_t idx = (size_t)ctx->rest;
     size_t block_size = (size_t)ctx->block_size;
+    size_t block_nb;
 
     if (ctx->rest & MYC_SHA3_FINALIZED)
         return; /* too late for additional input */
     ctx->rest = (unsigned)((ctx->rest + size) % block_size);
 
-    /* fill partial block */
+    /* complete the partial block */
     if (idx) {
         size_t left = block_size - idx;
-        memcpy((char *)ctx->message + idx, msg, (size < left ? size : left));
-        if (size < left)
+        if (size < left) {
+            myc_sha3_xor_bytes(ctx->hash, idx, msg, size);
             return;
-
-        /* process partial block */
-        myc_sha3_process_block(ctx->hash, ctx->message, block_size);
+        }
+        myc_sha3_xor_bytes(ctx->hash, idx, msg, left);
+        myc_dispatch.sha3_permutation(ctx->hash);
         msg += left;
         size -= left;
     }
-    while (size >= block_size) {
-        uint64_t *aligned_message_block;
-        if (IS_ALIGNED_64(msg)) {
-            /* the most common case is processing of an already aligned message
-            without copying it */
-            aligned_message_block = (uint64_t *)(void *)msg;
-        }
-        else {
-            memcpy(ctx->message, msg, block_size);
-            aligned_message_block = ctx->message;
-        }
-
-        myc_sha3_process_block(ctx->hash, aligned_message_block, block_size);
-        msg += block_size;
-        size -= block_size;
+    /* process full blocks in place */
+    block_nb = size / block_size;
+    if (block_nb) {
+        myc_sha3_process_blocks(ctx, msg, block_nb);
+        msg += block_nb * block_size;
+        size -= block_nb * block_size;
     }
+    /* start the next block with the leftovers */
     if (size) {
-        memcpy(ctx->message, msg, size); /* save leftovers */
+        myc_sha3_xor_bytes(ctx->hash, 0, msg, size);
+    }
+}
+/**
+ * Calculate message hash over several fragments, as calling
+ * myc_sha3_Update() on each of them in turn.
+ *
+ * @param ctx the algorithm context containing current hashing state
+ * @param iov message fragments
+ * @param cnt number of fragments
+ */
+void myc_sha3_Updatev(MYC_SHA3_CTX *ctx, const struct iovec *iov, int cnt)
+{
+    int i;
+
+    for (i = 0; i < cnt; i++) {
+        myc_sha3_Update(ctx, (const unsigned char *)iov[i].iov_base,
+                        iov[i].iov_len);
     }
 }
 
@@ -319,25 +371,101 @@ void myc_sha3_Update(MYC_SHA3_CTX *ctx, const unsigned char *msg, size_t size)
 void myc_sha3_Final(MYC_SHA3_CTX *ctx, unsigned char *result)
 {
     size_t digest_length = 100 - ctx->block_size / 2;
-    const size_t block_size = ctx->block_size;
-
-    if (!(ctx->rest & MYC_SHA3_FINALIZED)) {
-        /* clear the rest of the data queue */
-        memset((char *)ctx->message + ctx->rest, 0, block_size - ctx->rest);
-        ((char *)ctx->message)[ctx->rest] |= 0x06;
-        ((char *)ctx->message)[block_size - 1] |= 0x80;
 
-        /* process final block */
-        myc_sha3_process_block(ctx->hash, ctx->message, block_size);
-        ctx->rest = MYC_SHA3_FINALIZED; /* mark context as finalized */
-    }
+    myc_sha3_finalize(ctx, 0x06);
 
-    assert(block_size > digest_length);
+    assert(ctx->block_size > digest_length);
     if (result)
         me64_to_le_str(result, ctx->hash, digest_length);
     MEMSET_BZERO(ctx, sizeof(MYC_SHA3_CTX));
 }
 
+/**
+ * Squeeze length bytes of SHAKE output into the given array.
+ *
+ * @param ctx the algorithm context containing current hashing state
+ * @param result output in binary form
+ * @param length number of output bytes
+ */
+void myc_shake_Final(MYC_SHA3_CTX *ctx, unsigned char *result, size_t length)
+{
+    const size_t block_size = ctx->block_size;
+
+    myc_sha3_finalize(ctx, 0x1F);
+
+    while (result && length > 0) {
+        size_t n = length < block_size ? length : block_size;
+
+        me64_to_le_str(result, ctx->hash, n);
+        result += n;
+        length -= n;
+        if (length)
+            myc_dispatch.sha3_permutation(ctx->hash);
+    }
+    MEMSET_BZERO(ctx, sizeof(MYC_SHA3_CTX));
+}
+
+/**
+ * Pad and permute a copy of the state, for the digest of the input so
+ * far without finalizing the context.
+ *
+ * @param ctx the algorithm context, left as it is
+ * @param hash receives the permuted copy
+ * @param pad 0x06 for SHA3, 0x1F for SHAKE, 0x01 for Keccak
+ */
+static void myc_sha3_peek_state(const MYC_SHA3_CTX *ctx, uint64_t hash[25],
+                                unsigned char pad)
+{
+    unsigned char *state = (unsigned char *)hash;
+
+    assert(!(ctx->rest & MYC_SHA3_FINALIZED) && ctx->block_size != 0);
+    memcpy(hash, ctx->hash, sizeof(ctx->hash));
+    state[ctx->rest] ^= pad;
+    state[ctx->block_size - 1] ^= 0x80;
+    myc_dispatch.sha3_permutation(hash);
+}
+
+/**
+ * Store the hash of the input so far into the given array, the context
+ * can still be updated.
+ *
+ * @param ctx the algorithm context containing current hashing state
+ * @param result calculated hash in binary form
+ */
+void myc_sha3_peek(const MYC_SHA3_CTX *ctx, unsigned char *result)
+{
+    uint64_t hash[25];
+
+    myc_sha3_peek_state(ctx, hash, 0x06);
+    me64_to_le_str(result, hash, 100 - ctx->block_size / 2);
+}
+
+/**
+ * Squeeze length bytes of SHAKE output for the input so far, the
+ * context can still be updated.
+ *
+ * @param ctx the algorithm context containing current hashing state
+ * @param result output in binary form
+ * @param length number of output bytes
+ */
+void myc_shake_peek(const MYC_SHA3_CTX *ctx, unsigned char *result,
+                    size_t length)
+{
+    const size_t block_size = ctx->block_size;
+    uint64_t hash[25];
+
+    myc_sha3_peek_state(ctx, hash, 0x1F);
+    while (length > 0) {
+        size_t n = length < block_size ? length : block_size;
+
+        me64_to_le_str(result, hash, n);
+        result += n;
+        length -= n;
+        if (length)
+            myc_dispatch.sha3_permutation(hash);
+    }
+}
+
 #if USE_KECCAK
 /**
  * Store calculated hash into the given array.
@@ -348,20 +476,10 @@ void myc_sha3_Final(MYC_SHA3_CTX *ctx, unsigned char *result)
 void myc_keccak_Final(MYC_SHA3_CTX *ctx, unsigned char *result)
 {
     size_t digest_length = 100 - ctx->block_size / 2;
-    const size_t block_size = ctx->block_size;
-
-    if (!(ctx->rest & MYC_SHA3_FINALIZED)) {
-        /* clear the rest of the data queue */
-        memset((char *)ctx->message + ctx->rest, 0, block_size - ctx->rest);
-        ((char *)ctx->message)[ctx->rest] |= 0x01;
-        ((char *)ctx->message)[block_size - 1] |= 0x80;
 
-        /* process final block */
-        myc_sha3_process_block(ctx->hash, ctx->message, block_size);
-        ctx->rest = MYC_SHA3_FINALIZED; /* mark context as finalized */
-    }
+    myc_sha3_finalize(ctx, 0x01);
 
-    assert(block_size > digest_length);
+    assert(ctx->block_size > digest_length);
     if (result)
         me64_to_le_str(result, ctx->hash, digest_length);
     MEMSET_BZERO(ctx, sizeof(MYC_SHA3_CTX));
@@ -382,6 +500,21 @@ void myc_keccak_512(const unsigned char *data, size_t len, unsigned char *digest
     myc_keccak_Update(&ctx, data, len);
     myc_keccak_Final(&ctx, digest);
 }
+
+/**
+ * Store the Keccak hash of the input so far into the given array, the
+ * context can still be updated.
+ *
+ * @param ctx the algorithm context containing current hashing state
+ * @param result calculated hash in binary form
+ */
+void myc_keccak_peek(const MYC_SHA3_CTX *ctx, unsigned char *result)
+{
+    uint64_t hash[25];
+
+    myc_sha3_peek_state(ctx, hash, 0x01);
+    me64_to_le_str(result, hash, 100 - ctx->block_size / 2);
+}
 #endif /* USE_KECCAK */
 
 void myc_sha3_224(const unsigned char *data, size_t len, unsigned char *digest)
@@ -415,3 +548,21 @@ void myc_sha3_512(const unsigned char *data, size_t len, unsigned char *digest)
     myc_sha3_Update(&ctx, data, len);
     myc_sha3_Final(&ctx, digest);
 }
+
+void myc_shake128(const unsigned char *data, size_t len,
+                  unsigned char *result, size_t length)
+{
+    MYC_SHA3_CTX ctx;
+    myc_shake128_Init(&ctx);
+    myc_sha3_Update(&ctx, data, len);
+    myc_shake_Final(&ctx, result, length);
+}
+
+void myc_shake256(const unsigned char *data, size_t len,
+                  unsigned char *result, size_t length)
+{
+    MYC_SHA3_CTX ctx;
+    myc_shake256_Init(&ctx);
+    myc_sha3_Update(&ctx, data, len);
+    myc_shake_Final(&ctx, result, length);
+}
@@ -0,0 +1,119 @@
+/*
+ * Single-state Keccak-f[1600] permutation (AVX-512)
+ *
+ * A round starts with the state in five zmm registers holding its
+ * rows, lane x of row y being A[x + 5 * y] in the five low lanes. The
+ * three high lanes carry junk that never reaches the low ones.
+ *
+ * Theta needs the column parities rotated by one lane either way,
+ * taken with vpermq, and XORs them with vpternlogq. Rho is one
+ * vprolvq per row. Pi sends lane x of row y to lane y of row
+ * 2x + 3y, so the lanes of input row y all land in output column y:
+ * one vpermq per row turns the rows into the columns of the permuted
+ * state. Chi then combines whole columns with one vpternlogq each and
+ * needs no lane shuffle. A 5x5 transpose brings the rows back for the
+ * next round.
+ */
+
+#include "dispatch.h"
+
+#ifdef MYC_X86
+
+#include <immintrin.h>
+
+#define AVX512_TARGET __attribute__((target("avx512f")))
+
+/* Index vector, lane 0 first */
+#define IDX(a, b, c, d, e, f, g, h) _mm512_set_epi64(h, g, f, e, d, c, b, a)
+
+#define XOR3(a, b, c) _mm512_ternarylogic_epi64(a, b, c, 0x96)
+#define CHI(a, b, c)  _mm512_ternarylogic_epi64(a, b, c, 0xD2)
+
+#define PERM(idx, x)        _mm512_permutexvar_epi64(idx, x)
+#define PERM2(x, idx, y)    _mm512_permutex2var_epi64(x, idx, y)
+
+/* Row y of the transpose, lane 4 taken from column 4 */
+#define TRANSPOSE_ROW(p01, pair, p23, col4, y)                          \
+    _mm512_mask_permutexvar_epi64(PERM2(p01, pair, p23), 0x10,          \
+                                  _mm512_set1_epi64(y), col4)
+
+AVX512_TARGET
+void myc_sha3_permutation_avx512(uint64_t *state)
+{
+    const __m512i rot1 = IDX(1, 2, 3, 4, 0, 0, 0, 0);
+    const __m512i rot4 = IDX(4, 0, 1, 2, 3, 0, 0, 0);
+
+    const __m512i rho0 = IDX( 0,  1, 62, 28, 27, 0, 0, 0);
+    const __m512i rho1 = IDX(36, 44,  6, 55, 20, 0, 0, 0);
+    const __m512i rho2 = IDX( 3, 10, 43, 25, 39, 0, 0, 0);
+    const __m512i rho3 = IDX(41, 45, 15, 21,  8, 0, 0, 0);
+    const __m512i rho4 = IDX(18,  2, 61, 56, 14, 0, 0, 0);
+
+    /* Row x becomes column x, lane y taken from lane 3y + x mod 5 */
+    const __m512i pi0 = IDX(0, 3, 1, 4, 2, 0, 0, 0);
+    const __m512i pi1 = IDX(1, 4, 2, 0, 3, 0, 0, 0);
+    const __m512i pi2 = IDX(2, 0, 3, 1, 4, 0, 0, 0);
+    const __m512i pi3 = IDX(3, 1, 4, 2, 0, 0, 0, 0);
+    const __m512i pi4 = IDX(4, 2, 0, 3, 1, 0, 0, 0);
+
+    /* Interleaved lanes 0-3 and lane 4 of two columns */
+    const __m512i zip = IDX(0, 8, 1, 9, 2, 10, 3, 11);
+    const __m512i zip4 = IDX(4, 12, 0, 0, 0, 0, 0, 0);
+    const __m512i pair0 = IDX(0, 1,  8,  9, 0, 0, 0, 0);
+    const __m512i pair1 = IDX(2, 3, 10, 11, 0, 0, 0, 0);
+    const __m512i pair2 = IDX(4, 5, 12, 13, 0, 0, 0, 0);
+    const __m512i pair3 = IDX(6, 7, 14, 15, 0, 0, 0, 0);
+
+    __m512i r0, r1, r2, r3, r4, b0, b1, b2, b3, b4, c0, c1, c2, c3, c4;
+    __m512i c, d, p01, p23, q01, q23;
+    int round;
+
+    r0 = _mm512_maskz_loadu_epi64(0x1F, &state[ 0]);
+    r1 = _mm512_maskz_loadu_epi64(0x1F, &state[ 5]);
+    r2 = _mm512_maskz_loadu_epi64(0x1F, &state[10]);
+    r3 = _mm512_maskz_loadu_epi64(0x1F, &state[15]);
+    r4 = _mm512_maskz_loadu_epi64(0x1F, &state[20]);
+
+    for (round = 0; round < 24; round++) {
+        /* theta */
+        c = XOR3(XOR3(r0, r1, r2), r3, r4);
+        d = _mm512_xor_si512(PERM(rot4, c),
+                             _mm512_rol_epi64(PERM(rot1, c), 1));
+
+        /* rho and pi, rows to columns */
+        b0 = PERM(pi0, _mm512_rolv_epi64(_mm512_xor_si512(r0, d), rho0));
+        b1 = PERM(pi1, _mm512_rolv_epi64(_mm512_xor_si512(r1, d), rho1));
+        b2 = PERM(pi2, _mm512_rolv_epi64(_mm512_xor_si512(r2, d), rho2));
+        b3 = PERM(pi3, _mm512_rolv_epi64(_mm512_xor_si512(r3, d), rho3));
+        b4 = PERM(pi4, _mm512_rolv_epi64(_mm512_xor_si512(r4, d), rho4));
+
+        /* chi on columns, then iota */
+        c0 = CHI(b0, b1, b2);
+        c1 = CHI(b1, b2, b3);
+        c2 = CHI(b2, b3, b4);
+        c3 = CHI(b3, b4, b0);
+        c4 = CHI(b4, b0, b1);
+        c0 = _mm512_xor_si512(c0, _mm512_maskz_set1_epi64(0x01,
+                 (long long) myc_keccak_round_constants[round]));
+
+        /* columns back to rows */
+        p01 = PERM2(c0, zip, c1);
+        q01 = PERM2(c0, zip4, c1);
+        p23 = PERM2(c2, zip, c3);
+        q23 = PERM2(c2, zip4, c3);
+
+        r0 = TRANSPOSE_ROW(p01, pair0, p23, c4, 0);
+        r1 = TRANSPOSE_ROW(p01, pair1, p23, c4, 1);
+        r2 = TRANSPOSE_ROW(p01, pair2, p23, c4, 2);
+        r3 = TRANSPOSE_ROW(p01, pair3, p23, c4, 3);
+        r4 = TRANSPOSE_ROW(q01, pair0, q23, c4, 4);
+    }
+
+    _mm512_mask_storeu_epi64(&state[ 0], 0x1F, r0);
+    _mm512_mask_storeu_epi64(&state[ 5], 0x1F, r1);
+    _mm512_mask_storeu_epi64(&state[10], 0x1F, r2);
+    _mm512_mask_storeu_epi64(&state[15], 0x1F, r3);
+    _mm512_mask_storeu_epi64(&state[20], 0x1F, r4);
+}
+
+#endif /* MYC_X86 */
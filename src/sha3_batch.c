@@ -0,0 +1,175 @@
+/*
+ * SHA3/Keccak hashing of many independent messages
+ *
+ * Every step XORs the next block of the message of each state, the
+ * last block being padded in a buffer, then permutes all the states of
+ * the multi-buffer permutation together. A state whose message is
+ * absorbed is cleared and starts on the next message of the batch, so
+ * that states only go idle at the end of the batch, where they are
+ * permuted anyway and their result is ignored.
+ */
+
+#include <string.h>
+
+#include "dispatch.h"
+
+#define SHA3_MAX_LANES 8
+
+/* Delimited suffixes of the first padding byte */
+#define SHA3_PAD   0x06
+#define KECCAK_PAD 0x01
+
+static void sha3_absorb(uint64_t *state, unsigned int stride,
+                        const unsigned char *block, size_t rate)
+{
+    size_t i;
+    int j;
+
+    for (i = 0; i < rate / 8; i++) {
+        uint64_t w = 0;
+
+        for (j = 7; j >= 0; j--) {
+            w = (w << 8) | block[i * 8 + j];
+        }
+        state[i * stride] ^= w;
+    }
+}
+
+static void sha3_store(const uint64_t *state, unsigned int stride,
+                       unsigned char *digest, size_t digest_size)
+{
+    size_t i;
+
+    for (i = 0; i < digest_size; i++) {
+        digest[i] = (unsigned char) (state[(i / 8) * stride] >> (i % 8 * 8));
+    }
+}
+
+static void sha3_batch(size_t rate, unsigned char pad, size_t digest_size,
+                       const unsigned char **messages, const size_t *lens,
+                       size_t count, unsigned char *digests)
+{
+    uint64_t state[25 * SHA3_MAX_LANES];
+    unsigned char block[MYC_SHA3_224_BLOCK_LENGTH];
+    const unsigned char *data[SHA3_MAX_LANES];
+    size_t left[SHA3_MAX_LANES], msg[SHA3_MAX_LANES];
+    int active[SHA3_MAX_LANES], last[SHA3_MAX_LANES];
+    sha3_mb_impl mb;
+    sha3_mb_fn permute;
+    unsigned int lane_nb, remaining, l, i;
+    size_t next;
+
+    myc_dispatch_init();
+    mb = myc_dispatch.sha3_mb[MYC_BATCH_CLASS(count)];
+    lane_nb = mb.lanes;
+    permute = mb.fn;
+    if (mb.fn == NULL || lane_nb > SHA3_MAX_LANES) {
+        /* A single state is permuted by the one-stream permutation */
+        lane_nb = 1;
+        permute = myc_dispatch.sha3_permutation;
+    }
+
+    memset(state, 0, 25 * lane_nb * sizeof(state[0]));
+    next = 0;
+    remaining = 0;
+    for (l = 0; l < lane_nb; l++) {
+        active[l] = next < count;
+        last[l] = 0;
+        if (active[l]) {
+            msg[l] = next++;
+            data[l] = messages[msg[l]];
+            left[l] = lens[msg[l]];
+            remaining++;
+        }
+    }
+
+    while (remaining > 0) {
+        for (l = 0; l < lane_nb; l++) {
+            if (!active[l])
+                continue;
+            if (left[l] >= rate) {
+                sha3_absorb(&state[l], lane_nb, data[l], rate);
+                data[l] += rate;
+                left[l] -= rate;
+                continue;
+            }
+            /* an empty message may be NULL */
+            if (left[l] != 0)
+                memcpy(block, data[l], left[l]);
+            memset(block + left[l], 0, rate - left[l]);
+            block[left[l]] |= pad;
+            block[rate - 1] |= 0x80;
+            sha3_absorb(&state[l], lane_nb, block, rate);
+            active[l] = 0;
+            last[l] = 1;
+        }
+
+        permute(state);
+
+        for (l = 0; l < lane_nb; l++) {
+            if (!last[l])
+                continue;
+
+            sha3_store(&state[l], lane_nb, digests + msg[l] * digest_size,
+                       digest_size);
+            last[l] = 0;
+            if (next == count) {
+                remaining--;
+                continue;
+            }
+
+            /* refill the state with the next message */
+            for (i = 0; i < 25; i++) {
+                state[i * lane_nb + l] = 0;
+            }
+            msg[l] = next++;
+            data[l] = messages[msg[l]];
+            left[l] = lens[msg[l]];
+            active[l] = 1;
+        }
+    }
+}
+
+void myc_sha3_224_batch(const unsigned char **messages, const size_t *lens,
+                        size_t count, unsigned char *digests)
+{
+    sha3_batch(MYC_SHA3_224_BLOCK_LENGTH, SHA3_PAD,
+               MYC_SHA3_224_DIGEST_LENGTH, messages, lens, count, digests);
+}
+
+void myc_sha3_256_batch(const unsigned char **messages, const size_t *lens,
+                        size_t count, unsigned char *digests)
+{
+    sha3_batch(MYC_SHA3_256_BLOCK_LENGTH, SHA3_PAD,
+               MYC_SHA3_256_DIGEST_LENGTH, messages, lens, count, digests);
+}
+
+void myc_sha3_384_batch(const unsigned char **messages, const size_t *lens,
+                        size_t count, unsigned char *digests)
+{
+    sha3_batch(MYC_SHA3_384_BLOCK_LENGTH, SHA3_PAD,
+               MYC_SHA3_384_DIGEST_LENGTH, messages, lens, count, digests);
+}
+
+void myc_sha3_512_batch(const unsigned char **messages, const size_t *lens,
+                        size_t count, unsigned char *digests)
+{
+    sha3_batch(MYC_SHA3_512_BLOCK_LENGTH, SHA3_PAD,
+               MYC_SHA3_512_DIGEST_LENGTH, messages, lens, count, digests);
+}
+
+#if USE_KECCAK
+void myc_keccak_256_batch(const unsigned char **messages, const size_t *lens,
+                          size_t count, unsigned char *digests)
+{
+    sha3_batch(MYC_SHA3_256_BLOCK_LENGTH, KECCAK_PAD,
+               MYC_SHA3_256_DIGEST_LENGTH, messages, lens, count, digests);
+}
+
+void myc_keccak_512_batch(const unsigned char **messages, const size_t *lens,
+                          size_t count, unsigned char *digests)
+{
+    sha3_batch(MYC_SHA3_512_BLOCK_LENGTH, KECCAK_PAD,
+               MYC_SHA3_512_DIGEST_LENGTH, messages, lens, count, digests);
+}
+#endif /* USE_KECCAK */
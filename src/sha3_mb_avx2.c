@@ -0,0 +1,51 @@
+/*
+ * 4-way multi-buffer Keccak-f[1600] permutation (AVX2)
+ *
+ * Each 64-bit lane of a ymm register holds the same Keccak lane of one
+ * of four independent states. The states are stored lane-major:
+ * state[i * 4 + l] is lane i of state l, so every Keccak lane is one
+ * vector.
+ */
+
+#include "dispatch.h"
+#include "keccak_round.h"
+
+#ifdef MYC_X86
+
+#include <immintrin.h>
+
+#define MB_TARGET __attribute__((target("avx2")))
+
+#define KECCAK_XOR(x, y) _mm256_xor_si256(x, y)
+#define KECCAK_XOR5(a, b, c, d, e)                                      \
+    _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(a, b),           \
+                                      _mm256_xor_si256(c, d)), e)
+#define KECCAK_ROL(x, n) _mm256_or_si256(_mm256_slli_epi64(x, n),        \
+                                         _mm256_srli_epi64(x, 64 - (n)))
+#define KECCAK_CHI(x, y, z) _mm256_xor_si256(x, _mm256_andnot_si256(y, z))
+
+#define KECCAK_LOAD(lane, i)                                            \
+    lane = _mm256_loadu_si256((const __m256i *) &state[(i) * 4])
+#define KECCAK_STORE(lane, i)                                           \
+    _mm256_storeu_si256((__m256i *) &state[(i) * 4], lane)
+
+#define RC(round)                                                       \
+    _mm256_set1_epi64x((long long) myc_keccak_round_constants[round])
+
+MB_TARGET
+void myc_sha3_permutation_x4_avx2(uint64_t *state)
+{
+    KECCAK_LANES(__m256i, A);
+    KECCAK_LANES(__m256i, E);
+    KECCAK_TEMPS(__m256i);
+    int round;
+
+    KECCAK_MAP(A, KECCAK_LOAD);
+    for (round = 0; round < 24; round += 2) {
+        KECCAK_ROUND(A, E, RC(round));
+        KECCAK_ROUND(E, A, RC(round + 1));
+    }
+    KECCAK_MAP(A, KECCAK_STORE);
+}
+
+#endif /* MYC_X86 */
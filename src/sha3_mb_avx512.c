@@ -0,0 +1,47 @@
+/*
+ * 8-way multi-buffer Keccak-f[1600] permutation (AVX-512)
+ *
+ * Same layout as the AVX2 permutation with eight states, one per
+ * 64-bit lane of a zmm register. Rho uses vprolq, the theta parity and
+ * chi a vpternlogq per pair of operations.
+ */
+
+#include "dispatch.h"
+#include "keccak_round.h"
+
+#ifdef MYC_X86
+
+#include <immintrin.h>
+
+#define MB_TARGET __attribute__((target("avx512f")))
+
+#define KECCAK_XOR(x, y) _mm512_xor_si512(x, y)
+#define KECCAK_XOR5(a, b, c, d, e)                                      \
+    _mm512_ternarylogic_epi64(                                          \
+        _mm512_ternarylogic_epi64(a, b, c, 0x96), d, e, 0x96)
+#define KECCAK_ROL(x, n) _mm512_rol_epi64(x, n)
+#define KECCAK_CHI(x, y, z) _mm512_ternarylogic_epi64(x, y, z, 0xD2)
+
+#define KECCAK_LOAD(lane, i)  lane = _mm512_loadu_si512(&state[(i) * 8])
+#define KECCAK_STORE(lane, i) _mm512_storeu_si512(&state[(i) * 8], lane)
+
+#define RC(round)                                                       \
+    _mm512_set1_epi64((long long) myc_keccak_round_constants[round])
+
+MB_TARGET
+void myc_sha3_permutation_x8_avx512(uint64_t *state)
+{
+    KECCAK_LANES(__m512i, A);
+    KECCAK_LANES(__m512i, E);
+    KECCAK_TEMPS(__m512i);
+    int round;
+
+    KECCAK_MAP(A, KECCAK_LOAD);
+    for (round = 0; round < 24; round += 2) {
+        KECCAK_ROUND(A, E, RC(round));
+        KECCAK_ROUND(E, A, RC(round + 1));
+    }
+    KECCAK_MAP(A, KECCAK_STORE);
+}
+
+#endif /* MYC_X86 */
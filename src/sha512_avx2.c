@@ -0,0 +1,129 @@
+/*
+ * SHA-384/512 block transform with a SIMD message schedule (AVX2)
+ *
+ * The rounds are computed on general purpose registers, using RORX and
+ * ANDN from BMI1/BMI2, while the message schedule is computed four
+ * 64-bit words at a time in a ymm register. Each group of four rounds
+ * is interleaved with the schedule of the words needed sixteen rounds
+ * later, stored with their round constant added in a 16-entry circular
+ * buffer.
+ */
+
+#include "dispatch.h"
+
+#ifdef MYC_X86
+
+#include <immintrin.h>
+
+#define AVX2_TARGET __attribute__((target("avx2,bmi,bmi2")))
+
+#define ROTR(x, n)   ((x >> n) | (x << (64 - n)))
+#define CH(x, y, z)  ((x & y) ^ (~x & z))
+#define MAJ(x, y, z) ((x & y) | (z & (x | y)))
+
+#define S0(x) (ROTR(x, 28) ^ ROTR(x, 34) ^ ROTR(x, 39))
+#define S1(x) (ROTR(x, 14) ^ ROTR(x, 18) ^ ROTR(x, 41))
+
+#define ROUND(a, b, c, d, e, f, g, h, wk)                               \
+{                                                                       \
+    t1 = h + S1(e) + CH(e, f, g) + (wk);                                \
+    t2 = S0(a) + MAJ(a, b, c);                                          \
+    d += t1;                                                            \
+    h = t1 + t2;                                                        \
+}
+
+/* Rounds j..j+3, after which the roles of a..h move by four */
+#define ROUND4(a, b, c, d, e, f, g, h, j)                               \
+{                                                                       \
+    ROUND(a, b, c, d, e, f, g, h, wk[((j) + 0) & 15]);                  \
+    ROUND(h, a, b, c, d, e, f, g, wk[((j) + 1) & 15]);                  \
+    ROUND(g, h, a, b, c, d, e, f, wk[((j) + 2) & 15]);                  \
+    ROUND(f, g, h, a, b, c, d, e, wk[((j) + 3) & 15]);                  \
+}
+
+#define YROTR(x, n) _mm256_or_si256(_mm256_srli_epi64(x, n),            \
+                                    _mm256_slli_epi64(x, 64 - (n)))
+
+#define YSIGMA0(x) _mm256_xor_si256(_mm256_xor_si256(YROTR(x, 1),       \
+                       YROTR(x, 8)), _mm256_srli_epi64(x, 7))
+#define YSIGMA1(x) _mm256_xor_si256(_mm256_xor_si256(YROTR(x, 19),      \
+                       YROTR(x, 61)), _mm256_srli_epi64(x, 6))
+
+/* Words 1..4 of the eight words of x0 followed by x1 */
+#define YALIGN1(x1, x0)                                                 \
+    _mm256_alignr_epi8(_mm256_permute2x128_si256(x0, x1, 0x21), x0, 8)
+
+/*
+ * W[t..t+3] into x0, which holds W[t-16..t-13] and x1..x3 the next
+ * words up to W[t-1]. sigma1 needs W[t-2..t+1], so the two high words
+ * are finished after the two low ones.
+ */
+#define YSCHED(x0, x1, x2, x3)                                          \
+{                                                                       \
+    w15 = YALIGN1(x1, x0);                                              \
+    w7 = YALIGN1(x3, x2);                                               \
+    x0 = _mm256_add_epi64(_mm256_add_epi64(x0, w7), YSIGMA0(w15));      \
+    tmp = _mm256_permute4x64_epi64(x3, 0xEE);                           \
+    x0 = _mm256_add_epi64(x0,                                           \
+             _mm256_blend_epi32(YSIGMA1(tmp), zero, 0xF0));             \
+    tmp = _mm256_permute4x64_epi64(x0, 0x44);                           \
+    x0 = _mm256_add_epi64(x0,                                           \
+             _mm256_blend_epi32(YSIGMA1(tmp), zero, 0x0F));             \
+}
+
+#define YSTORE_WK(x, j)                                                 \
+    _mm256_store_si256((__m256i *) &wk[(j) & 15], _mm256_add_epi64(x,   \
+        _mm256_loadu_si256((const __m256i *) &sha512_k[j])))
+
+/* Rounds j..j+3 while scheduling W[j+16..j+19] */
+#define SCHED_ROUND4(x0, x1, x2, x3, a, b, c, d, e, f, g, h, j)         \
+{                                                                       \
+    YSCHED(x0, x1, x2, x3);                                             \
+    ROUND4(a, b, c, d, e, f, g, h, j);                                  \
+    YSTORE_WK(x0, (j) + 16);                                            \
+}
+
+#define YLOAD(x, offset)                                                \
+    x = _mm256_shuffle_epi8(_mm256_loadu_si256(                         \
+            (const __m256i *) (message + (offset))), bswap)
+
+AVX2_TARGET
+void sha512_transf_avx2(uint64 *h, const unsigned char *message,
+                        size_t block_nb)
+{
+    const __m256i bswap = _mm256_set_epi8(
+        8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7,
+        8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i zero = _mm256_setzero_si256();
+    uint64 wk[16] __attribute__((aligned(32)));
+    uint64 a, b, c, d, e, f, g, hh, t1, t2;
+    __m256i x0, x1, x2, x3, w15, w7, tmp;
+    int j;
+
+    a = h[0]; b = h[1]; c = h[2]; d = h[3];
+    e = h[4]; f = h[5]; g = h[6]; hh = h[7];
+
+    while (block_nb--) {
+        YLOAD(x0,  0); YLOAD(x1, 32); YLOAD(x2, 64); YLOAD(x3, 96);
+        YSTORE_WK(x0, 0); YSTORE_WK(x1, 4);
+        YSTORE_WK(x2, 8); YSTORE_WK(x3, 12);
+
+        for (j = 0; j < 64; j += 16) {
+            SCHED_ROUND4(x0, x1, x2, x3, a, b, c, d, e, f, g, hh, j +  0);
+            SCHED_ROUND4(x1, x2, x3, x0, e, f, g, hh, a, b, c, d, j +  4);
+            SCHED_ROUND4(x2, x3, x0, x1, a, b, c, d, e, f, g, hh, j +  8);
+            SCHED_ROUND4(x3, x0, x1, x2, e, f, g, hh, a, b, c, d, j + 12);
+        }
+        ROUND4(a, b, c, d, e, f, g, hh, 64);
+        ROUND4(e, f, g, hh, a, b, c, d, 68);
+        ROUND4(a, b, c, d, e, f, g, hh, 72);
+        ROUND4(e, f, g, hh, a, b, c, d, 76);
+
+        a = h[0] += a; b = h[1] += b; c = h[2] += c; d = h[3] += d;
+        e = h[4] += e; f = h[5] += f; g = h[6] += g; hh = h[7] += hh;
+
+        message += MYC_SHA512_BLOCK_SIZE;
+    }
+}
+
+#endif /* MYC_X86 */
@@ -0,0 +1,142 @@
+/*
+ * 4-lane multi-buffer SHA-384/512 block transform (AVX2)
+ *
+ * Each 64-bit lane of a ymm register carries one independent message
+ * stream. The chaining state is stored word-major: state[i * 4 + l] is
+ * word i of lane l, so every state word is one vector.
+ */
+
+#include "dispatch.h"
+
+#ifdef MYC_X86
+
+#include <immintrin.h>
+
+#define MB_TARGET __attribute__((target("avx2")))
+
+#define ROTR64(x, n) _mm256_or_si256(_mm256_srli_epi64(x, n),            \
+                                     _mm256_slli_epi64(x, 64 - (n)))
+
+#define S0(x) _mm256_xor_si256(_mm256_xor_si256(ROTR64(x, 28),           \
+                               ROTR64(x, 34)), ROTR64(x, 39))
+#define S1(x) _mm256_xor_si256(_mm256_xor_si256(ROTR64(x, 14),           \
+                               ROTR64(x, 18)), ROTR64(x, 41))
+#define s0(x) _mm256_xor_si256(_mm256_xor_si256(ROTR64(x,  1),           \
+                               ROTR64(x,  8)), _mm256_srli_epi64(x, 7))
+#define s1(x) _mm256_xor_si256(_mm256_xor_si256(ROTR64(x, 19),           \
+                               ROTR64(x, 61)), _mm256_srli_epi64(x, 6))
+
+#define CH(x, y, z)  _mm256_xor_si256(_mm256_and_si256(x, y),             \
+                                      _mm256_andnot_si256(x, z))
+#define MAJ(x, y, z) _mm256_or_si256(_mm256_and_si256(x, y),              \
+                         _mm256_and_si256(z, _mm256_or_si256(x, y)))
+
+#define ADD(x, y) _mm256_add_epi64(x, y)
+
+/* Message schedule word t >= 16, kept in a circular 16-entry buffer */
+#define SCHED(t)                                                        \
+{                                                                       \
+    w[(t) & 15] = ADD(ADD(w[(t) & 15], s0(w[((t) - 15) & 15])),         \
+                      ADD(w[((t) - 7) & 15], s1(w[((t) - 2) & 15])));   \
+}
+
+#define ROUND(a, b, c, d, e, f, g, h, t)                                \
+{                                                                       \
+    t1 = ADD(ADD(ADD(h, S1(e)), ADD(CH(e, f, g), w[(t) & 15])),         \
+             _mm256_set1_epi64x((long long) sha512_k[t]));              \
+    t2 = ADD(S0(a), MAJ(a, b, c));                                      \
+    d = ADD(d, t1);                                                     \
+    h = ADD(t1, t2);                                                    \
+}
+
+#define ROUND8(t)                                                       \
+{                                                                       \
+    ROUND(a, b, c, d, e, f, g, h, (t) + 0);                             \
+    ROUND(h, a, b, c, d, e, f, g, (t) + 1);                             \
+    ROUND(g, h, a, b, c, d, e, f, (t) + 2);                             \
+    ROUND(f, g, h, a, b, c, d, e, (t) + 3);                             \
+    ROUND(e, f, g, h, a, b, c, d, (t) + 4);                             \
+    ROUND(d, e, f, g, h, a, b, c, (t) + 5);                             \
+    ROUND(c, d, e, f, g, h, a, b, (t) + 6);                             \
+    ROUND(b, c, d, e, f, g, h, a, (t) + 7);                             \
+}
+
+#define SCHED8(t)                                                       \
+{                                                                       \
+    SCHED((t) + 0); SCHED((t) + 1); SCHED((t) + 2); SCHED((t) + 3);     \
+    SCHED((t) + 4); SCHED((t) + 5); SCHED((t) + 6); SCHED((t) + 7);     \
+}
+
+/* Load 4 big-endian words from each lane, transposed to word-major */
+MB_TARGET
+static void load_words(__m256i *out, const unsigned char *const *data,
+                       size_t offset)
+{
+    const __m256i bswap = _mm256_set_epi8(
+        8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7,
+        8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i r0, r1, r2, r3, t0, t1, t2, t3;
+
+    r0 = _mm256_loadu_si256((const __m256i *) (data[0] + offset));
+    r1 = _mm256_loadu_si256((const __m256i *) (data[1] + offset));
+    r2 = _mm256_loadu_si256((const __m256i *) (data[2] + offset));
+    r3 = _mm256_loadu_si256((const __m256i *) (data[3] + offset));
+
+    t0 = _mm256_unpacklo_epi64(r0, r1);
+    t1 = _mm256_unpackhi_epi64(r0, r1);
+    t2 = _mm256_unpacklo_epi64(r2, r3);
+    t3 = _mm256_unpackhi_epi64(r2, r3);
+
+    out[0] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(t0, t2, 0x20),
+                                 bswap);
+    out[1] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(t1, t3, 0x20),
+                                 bswap);
+    out[2] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(t0, t2, 0x31),
+                                 bswap);
+    out[3] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(t1, t3, 0x31),
+                                 bswap);
+}
+
+MB_TARGET
+void sha512_transf_x4_avx2(uint64 *state, const unsigned char *const *data,
+                           size_t block_nb)
+{
+    __m256i a, b, c, d, e, f, g, h, t1, t2;
+    __m256i w[16];
+    size_t i;
+
+    for (i = 0; i < block_nb; i++) {
+        size_t offset = i * MYC_SHA512_BLOCK_SIZE;
+
+        load_words(&w[0], data, offset);
+        load_words(&w[4], data, offset + 32);
+        load_words(&w[8], data, offset + 64);
+        load_words(&w[12], data, offset + 96);
+
+        a = _mm256_loadu_si256((const __m256i *) &state[0 * 4]);
+        b = _mm256_loadu_si256((const __m256i *) &state[1 * 4]);
+        c = _mm256_loadu_si256((const __m256i *) &state[2 * 4]);
+        d = _mm256_loadu_si256((const __m256i *) &state[3 * 4]);
+        e = _mm256_loadu_si256((const __m256i *) &state[4 * 4]);
+        f = _mm256_loadu_si256((const __m256i *) &state[5 * 4]);
+        g = _mm256_loadu_si256((const __m256i *) &state[6 * 4]);
+        h = _mm256_loadu_si256((const __m256i *) &state[7 * 4]);
+
+        ROUND8( 0); ROUND8( 8);
+        SCHED8(16); ROUND8(16); SCHED8(24); ROUND8(24);
+        SCHED8(32); ROUND8(32); SCHED8(40); ROUND8(40);
+        SCHED8(48); ROUND8(48); SCHED8(56); ROUND8(56);
+        SCHED8(64); ROUND8(64); SCHED8(72); ROUND8(72);
+
+#define STORE_ADD(i, x)                                                 \
+        _mm256_storeu_si256((__m256i *) &state[(i) * 4],                \
+            ADD(x, _mm256_loadu_si256((const __m256i *) &state[(i) * 4])))
+
+        STORE_ADD(0, a); STORE_ADD(1, b); STORE_ADD(2, c); STORE_ADD(3, d);
+        STORE_ADD(4, e); STORE_ADD(5, f); STORE_ADD(6, g); STORE_ADD(7, h);
+
+#undef STORE_ADD
+    }
+}
+
+#endif /* MYC_X86 */
@@ -0,0 +1,153 @@
+/*
+ * 8-lane multi-buffer SHA-384/512 block transform (AVX-512)
+ *
+ * Same layout as the AVX2 transform with one stream per 64-bit lane of
+ * a zmm register. Rotations use vprorq and the three-input boolean
+ * functions (Ch, Maj and the sigma XORs) a single vpternlogq each.
+ */
+
+#include "dispatch.h"
+
+#ifdef MYC_X86
+
+#include <immintrin.h>
+
+#define MB_TARGET __attribute__((target("avx512f")))
+
+#define XOR3(x, y, z) _mm512_ternarylogic_epi64(x, y, z, 0x96)
+
+#define S0(x) XOR3(_mm512_ror_epi64(x, 28), _mm512_ror_epi64(x, 34),      \
+                   _mm512_ror_epi64(x, 39))
+#define S1(x) XOR3(_mm512_ror_epi64(x, 14), _mm512_ror_epi64(x, 18),      \
+                   _mm512_ror_epi64(x, 41))
+#define s0(x) XOR3(_mm512_ror_epi64(x,  1), _mm512_ror_epi64(x,  8),      \
+                   _mm512_srli_epi64(x, 7))
+#define s1(x) XOR3(_mm512_ror_epi64(x, 19), _mm512_ror_epi64(x, 61),      \
+                   _mm512_srli_epi64(x, 6))
+
+#define CH(x, y, z)  _mm512_ternarylogic_epi64(x, y, z, 0xCA)
+#define MAJ(x, y, z) _mm512_ternarylogic_epi64(x, y, z, 0xE8)
+
+#define ADD(x, y) _mm512_add_epi64(x, y)
+
+#define SCHED(t)                                                        \
+{                                                                       \
+    w[(t) & 15] = ADD(ADD(w[(t) & 15], s0(w[((t) - 15) & 15])),         \
+                      ADD(w[((t) - 7) & 15], s1(w[((t) - 2) & 15])));   \
+}
+
+#define ROUND(a, b, c, d, e, f, g, h, t)                                \
+{                                                                       \
+    t1 = ADD(ADD(ADD(h, S1(e)), ADD(CH(e, f, g), w[(t) & 15])),         \
+             _mm512_set1_epi64((long long) sha512_k[t]));               \
+    t2 = ADD(S0(a), MAJ(a, b, c));                                      \
+    d = ADD(d, t1);                                                     \
+    h = ADD(t1, t2);                                                    \
+}
+
+#define ROUND8(t)                                                       \
+{                                                                       \
+    ROUND(a, b, c, d, e, f, g, h, (t) + 0);                             \
+    ROUND(h, a, b, c, d, e, f, g, (t) + 1);                             \
+    ROUND(g, h, a, b, c, d, e, f, (t) + 2);                             \
+    ROUND(f, g, h, a, b, c, d, e, (t) + 3);                             \
+    ROUND(e, f, g, h, a, b, c, d, (t) + 4);                             \
+    ROUND(d, e, f, g, h, a, b, c, (t) + 5);                             \
+    ROUND(c, d, e, f, g, h, a, b, (t) + 6);                             \
+    ROUND(b, c, d, e, f, g, h, a, (t) + 7);                             \
+}
+
+#define SCHED8(t)                                                       \
+{                                                                       \
+    SCHED((t) + 0); SCHED((t) + 1); SCHED((t) + 2); SCHED((t) + 3);     \
+    SCHED((t) + 4); SCHED((t) + 5); SCHED((t) + 6); SCHED((t) + 7);     \
+}
+
+/* Transpose 4 words of 4 lanes, out[i] holds word i of every lane */
+MB_TARGET
+static void transpose4(__m256i *out, const unsigned char *const *data,
+                       size_t offset)
+{
+    __m256i r0, r1, r2, r3, t0, t1, t2, t3;
+
+    r0 = _mm256_loadu_si256((const __m256i *) (data[0] + offset));
+    r1 = _mm256_loadu_si256((const __m256i *) (data[1] + offset));
+    r2 = _mm256_loadu_si256((const __m256i *) (data[2] + offset));
+    r3 = _mm256_loadu_si256((const __m256i *) (data[3] + offset));
+
+    t0 = _mm256_unpacklo_epi64(r0, r1);
+    t1 = _mm256_unpackhi_epi64(r0, r1);
+    t2 = _mm256_unpacklo_epi64(r2, r3);
+    t3 = _mm256_unpackhi_epi64(r2, r3);
+
+    out[0] = _mm256_permute2x128_si256(t0, t2, 0x20);
+    out[1] = _mm256_permute2x128_si256(t1, t3, 0x20);
+    out[2] = _mm256_permute2x128_si256(t0, t2, 0x31);
+    out[3] = _mm256_permute2x128_si256(t1, t3, 0x31);
+}
+
+/* Load 4 big-endian words from each of the 8 lanes, word-major */
+MB_TARGET
+static void load_words(__m512i *out, const unsigned char *const *data,
+                       size_t offset)
+{
+    const __m256i bswap = _mm256_set_epi8(
+        8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7,
+        8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i lo[4], hi[4];
+    int i;
+
+    transpose4(lo, data, offset);
+    transpose4(hi, data + 4, offset);
+
+    for (i = 0; i < 4; i++) {
+        __m256i x = _mm256_shuffle_epi8(lo[i], bswap);
+        __m256i y = _mm256_shuffle_epi8(hi[i], bswap);
+
+        out[i] = _mm512_inserti64x4(_mm512_castsi256_si512(x), y, 1);
+    }
+}
+
+MB_TARGET
+void sha512_transf_x8_avx512(uint64 *state, const unsigned char *const *data,
+                             size_t block_nb)
+{
+    __m512i a, b, c, d, e, f, g, h, t1, t2;
+    __m512i w[16];
+    size_t i;
+
+    for (i = 0; i < block_nb; i++) {
+        size_t offset = i * MYC_SHA512_BLOCK_SIZE;
+
+        load_words(&w[0], data, offset);
+        load_words(&w[4], data, offset + 32);
+        load_words(&w[8], data, offset + 64);
+        load_words(&w[12], data, offset + 96);
+
+        a = _mm512_loadu_si512(&state[0 * 8]);
+        b = _mm512_loadu_si512(&state[1 * 8]);
+        c = _mm512_loadu_si512(&state[2 * 8]);
+        d = _mm512_loadu_si512(&state[3 * 8]);
+        e = _mm512_loadu_si512(&state[4 * 8]);
+        f = _mm512_loadu_si512(&state[5 * 8]);
+        g = _mm512_loadu_si512(&state[6 * 8]);
+        h = _mm512_loadu_si512(&state[7 * 8]);
+
+        ROUND8( 0); ROUND8( 8);
+        SCHED8(16); ROUND8(16); SCHED8(24); ROUND8(24);
+        SCHED8(32); ROUND8(32); SCHED8(40); ROUND8(40);
+        SCHED8(48); ROUND8(48); SCHED8(56); ROUND8(56);
+        SCHED8(64); ROUND8(64); SCHED8(72); ROUND8(72);
+
+#define STORE_ADD(i, x)                                                 \
+        _mm512_storeu_si512(&state[(i) * 8],                            \
+                            ADD(x, _mm512_loadu_si512(&state[(i) * 8])))
+
+        STORE_ADD(0, a); STORE_ADD(1, b); STORE_ADD(2, c); STORE_ADD(3, d);
+        STORE_ADD(4, e); STORE_ADD(5, f); STORE_ADD(6, g); STORE_ADD(7, h);
+
+#undef STORE_ADD
+    }
+}
+
+#endif /* MYC_X86 */
@@ -0,0 +1,288 @@
+/*
+ * Export and import of intermediate hash states
+ *
+ * A state is exported as a byte string of fixed size for each
+ * algorithm, independent of the host and of the context layout:
+ *
+ *   byte 0    format version, STATE_FORMAT
+ *   byte 1    algorithm, one of the STATE_* identifiers
+ *   Merkle-Damgard hashes:
+ *             message length in bytes, 64 bits (128 for SHA-384/512),
+ *             big-endian
+ *             chaining value, in the byte order of the digest
+ *             the length % block size bytes of the partial block,
+ *             then zeros up to a full block
+ *   Keccak sponge:
+ *             rate in bytes, then the number of bytes of the current
+ *             block already absorbed
+ *             the 25 lanes, little-endian
+ *
+ * Importing checks the version and the algorithm, so that a string of
+ * another algorithm or format is rejected. A Keccak state must also have
+ * the rate of one of the SHA3/SHAKE/Keccak variants and fewer absorbed
+ * bytes than the rate. The variant itself is not recorded, as states of
+ * the same rate are interchangeable. A finalized Keccak context has no
+ * stream left to resume and is not exported.
+ */
+
+#include <string.h>
+
+#include "ripemd160.h"
+#include "sha2.h"
+#include "sha3.h"
+
+#define STATE_FORMAT 1
+
+#define STATE_SHA224    1
+#define STATE_SHA256    2
+#define STATE_SHA384    3
+#define STATE_SHA512    4
+#define STATE_RIPEMD160 5
+#define STATE_KECCAK    6
+
+static void put_be(unsigned char *p, uint64_t x, int n)
+{
+    int i;
+
+    for (i = n - 1; i >= 0; i--, x >>= 8)
+        p[i] = (unsigned char) x;
+}
+
+static uint64_t get_be(const unsigned char *p, int n)
+{
+    uint64_t x = 0;
+    int i;
+
+    for (i = 0; i < n; i++)
+        x = (x << 8) | p[i];
+    return x;
+}
+
+static void put_le(unsigned char *p, uint64_t x, int n)
+{
+    int i;
+
+    for (i = 0; i < n; i++, x >>= 8)
+        p[i] = (unsigned char) x;
+}
+
+static uint64_t get_le(const unsigned char *p, int n)
+{
+    uint64_t x = 0;
+    int i;
+
+    for (i = n - 1; i >= 0; i--)
+        x = (x << 8) | p[i];
+    return x;
+}
+
+static int check_header(const unsigned char *state, int algorithm)
+{
+    return state[0] == STATE_FORMAT && state[1] == algorithm ? 0 : -1;
+}
+
+/* SHA-224/256: header, 8-byte length, 8 words, 64-byte block */
+
+static void sha256_export(const myc_sha256_ctx *ctx, unsigned char *state,
+                          int algorithm)
+{
+    unsigned char *p = state + 2;
+    int i;
+
+    state[0] = STATE_FORMAT;
+    state[1] = (unsigned char) algorithm;
+    put_be(p, ctx->tot_len + ctx->len, 8);
+    p += 8;
+    for (i = 0; i < 8; i++, p += 4)
+        put_be(p, ctx->h[i], 4);
+    memcpy(p, ctx->block, ctx->len);
+    memset(p + ctx->len, 0, MYC_SHA256_BLOCK_SIZE - ctx->len);
+}
+
+static int sha256_import(myc_sha256_ctx *ctx, const unsigned char *state,
+                         int algorithm)
+{
+    const unsigned char *p = state + 10;
+    uint64 count;
+    int i;
+
+    if (check_header(state, algorithm) != 0)
+        return -1;
+    count = get_be(state + 2, 8);
+    for (i = 0; i < 8; i++, p += 4)
+        ctx->h[i] = (uint32) get_be(p, 4);
+    ctx->len = (unsigned int) (count % MYC_SHA256_BLOCK_SIZE);
+    ctx->tot_len = count - ctx->len;
+    memcpy(ctx->block, p, ctx->len);
+    return 0;
+}
+
+/* SHA-384/512: header, 16-byte length, 8 words, 128-byte block */
+
+static void sha512_export(const myc_sha512_ctx *ctx, unsigned char *state,
+                          int algorithm)
+{
+    unsigned char *p = state + 2;
+    uint64 count = ctx->tot_len[0] + ctx->len;
+    int i;
+
+    state[0] = STATE_FORMAT;
+    state[1] = (unsigned char) algorithm;
+    put_be(p, ctx->tot_len[1] + (count < ctx->len), 8);
+    put_be(p + 8, count, 8);
+    p += 16;
+    for (i = 0; i < 8; i++, p += 8)
+        put_be(p, ctx->h[i], 8);
+    memcpy(p, ctx->block, ctx->len);
+    memset(p + ctx->len, 0, MYC_SHA512_BLOCK_SIZE - ctx->len);
+}
+
+static int sha512_import(myc_sha512_ctx *ctx, const unsigned char *state,
+                         int algorithm)
+{
+    const unsigned char *p = state + 18;
+    uint64 count;
+    int i;
+
+    if (check_header(state, algorithm) != 0)
+        return -1;
+    count = get_be(state + 10, 8);
+    for (i = 0; i < 8; i++, p += 8)
+        ctx->h[i] = get_be(p, 8);
+    ctx->len = (unsigned int) (count % MYC_SHA512_BLOCK_SIZE);
+    ctx->tot_len[0] = count - ctx->len;
+    ctx->tot_len[1] = get_be(state + 2, 8);
+    memcpy(ctx->block, p, ctx->len);
+    return 0;
+}
+
+void myc_sha224_export_state(const myc_sha224_ctx *ctx,
+                             unsigned char state[MYC_SHA224_STATE_SIZE])
+{
+    sha256_export(ctx, state, STATE_SHA224);
+}
+
+int myc_sha224_import_state(myc_sha224_ctx *ctx,
+                            const unsigned char state[MYC_SHA224_STATE_SIZE])
+{
+    return sha256_import(ctx, state, STATE_SHA224);
+}
+
+void myc_sha256_export_state(const myc_sha256_ctx *ctx,
+                             unsigned char state[MYC_SHA256_STATE_SIZE])
+{
+    sha256_export(ctx, state, STATE_SHA256);
+}
+
+int myc_sha256_import_state(myc_sha256_ctx *ctx,
+                            const unsigned char state[MYC_SHA256_STATE_SIZE])
+{
+    return sha256_import(ctx, state, STATE_SHA256);
+}
+
+void myc_sha384_export_state(const myc_sha384_ctx *ctx,
+                             unsigned char state[MYC_SHA384_STATE_SIZE])
+{
+    sha512_export(ctx, state, STATE_SHA384);
+}
+
+int myc_sha384_import_state(myc_sha384_ctx *ctx,
+                            const unsigned char state[MYC_SHA384_STATE_SIZE])
+{
+    return sha512_import(ctx, state, STATE_SHA384);
+}
+
+void myc_sha512_export_state(const myc_sha512_ctx *ctx,
+                             unsigned char state[MYC_SHA512_STATE_SIZE])
+{
+    sha512_export(ctx, state, STATE_SHA512);
+}
+
+int myc_sha512_import_state(myc_sha512_ctx *ctx,
+                            const unsigned char state[MYC_SHA512_STATE_SIZE])
+{
+    return sha512_import(ctx, state, STATE_SHA512);
+}
+
+/* RIPEMD-160: header, 8-byte length, 5 little-endian words, block */
+
+void myc_ripemd160_export_state(const MYC_RIPEMD160_CTX *ctx,
+                                uint8_t state[MYC_RIPEMD160_STATE_SIZE])
+{
+    uint8_t *p = state + 10;
+    uint32_t left = ctx->total[0] & 0x3F;
+    int i;
+
+    state[0] = STATE_FORMAT;
+    state[1] = STATE_RIPEMD160;
+    put_be(state + 2, ((uint64_t) ctx->total[1] << 32) | ctx->total[0], 8);
+    for (i = 0; i < 5; i++, p += 4)
+        put_le(p, ctx->state[i], 4);
+    memcpy(p, ctx->buffer, left);
+    memset(p + left, 0, MYC_RIPEMD160_BLOCK_LENGTH - left);
+}
+
+int myc_ripemd160_import_state(MYC_RIPEMD160_CTX *ctx,
+                               const uint8_t state[MYC_RIPEMD160_STATE_SIZE])
+{
+    const uint8_t *p = state + 10;
+    uint64_t count;
+    int i;
+
+    if (check_header(state, STATE_RIPEMD160) != 0)
+        return -1;
+    count = get_be(state + 2, 8);
+    ctx->total[0] = (uint32_t) count;
+    ctx->total[1] = (uint32_t) (count >> 32);
+    for (i = 0; i < 5; i++, p += 4)
+        ctx->state[i] = (uint32_t) get_le(p, 4);
+    memcpy(ctx->buffer, p, ctx->total[0] & 0x3F);
+    return 0;
+}
+
+/* Keccak: header, rate, absorbed bytes, 25 little-endian lanes */
+
+static int sha3_rate_valid(unsigned rate)
+{
+    return rate == MYC_SHA3_224_BLOCK_LENGTH
+        || rate == MYC_SHA3_256_BLOCK_LENGTH
+        || rate == MYC_SHA3_384_BLOCK_LENGTH
+        || rate == MYC_SHA3_512_BLOCK_LENGTH
+        || rate == MYC_SHAKE128_BLOCK_LENGTH;
+}
+
+int myc_sha3_export_state(const MYC_SHA3_CTX *ctx,
+                          unsigned char state[MYC_SHA3_STATE_SIZE])
+{
+    unsigned char *p = state + 4;
+    int i;
+
+    /* Final wipes the context, and a finalized one has its flag in rest */
+    if (!sha3_rate_valid(ctx->block_size) || ctx->rest >= ctx->block_size)
+        return -1;
+    state[0] = STATE_FORMAT;
+    state[1] = STATE_KECCAK;
+    state[2] = (unsigned char) ctx->block_size;
+    state[3] = (unsigned char) ctx->rest;
+    for (i = 0; i < 25; i++, p += 8)
+        put_le(p, ctx->hash[i], 8);
+    return 0;
+}
+
+int myc_sha3_import_state(MYC_SHA3_CTX *ctx,
+                          const unsigned char state[MYC_SHA3_STATE_SIZE])
+{
+    const unsigned char *p = state + 4;
+    unsigned rate = state[2];
+    int i;
+
+    if (check_header(state, STATE_KECCAK) != 0)
+        return -1;
+    if (!sha3_rate_valid(rate) || state[3] >= rate)
+        return -1;
+    ctx->block_size = rate;
+    ctx->rest = state[3];
+    for (i = 0; i < 25; i++, p += 8)
+        ctx->hash[i] = get_le(p, 8);
+    return 0;
+}